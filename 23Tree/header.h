@@ -5,14 +5,35 @@
 #include <math.h>
 #include <time.h>
 
+#define NODE23_BLOCK 256 // nodes per pool block
+
 typedef struct node23_struct {
-    void **keys;
-    void **data;
-    struct node23_struct **children;
+    void *keys[2];
+    struct node23_struct *children[3];
+    void *data[2];
+    struct node23_struct *parent;
     int key_count;
+    int count; // entries in this subtree
     bool is_leaf;
-    struct node23_struct *parent;
-} Node23;
+} Node23; // 80 bytes; keys and children come first, as a descent reads them
+
+typedef struct node23_block_struct {
+    struct node23_block_struct *next;
+    int used;
+    Node23 nodes[NODE23_BLOCK];
+} Node23Block;
+
+// Nodes come from a pool that split trees share. Concatenating trees from
+// different pools moves one pool's blocks into the other and leaves a
+// forwarding pointer, so trees still holding the old pool find the new one.
+typedef struct node23_pool_struct {
+    Node23Block *blocks;
+    Node23Block *blocks_tail;
+    Node23 *free_nodes; // released nodes, chained through ->parent
+    Node23 *free_tail;
+    int refs; // trees using the pool, plus pools forwarded to it
+    struct node23_pool_struct *merged_into;
+} Node23Pool;
 
 typedef struct tree23_struct {
     int size;
@@ -22,6 +43,7 @@ typedef struct tree23_struct {
     void (*free_data)(void *); 
     void (*free_key)(void *);
     Node23 *root;
+    Node23Pool *pool; // created with the first node
 } Tree23;
 
 Tree23 *create_tree(int (*compare_func)(const void *, const void *), 
@@ -31,7 +53,13 @@ Tree23 *create_tree(int (*compare_func)(const void *, const void *),
                    void (*free_key)(void *));
 void free_tree(Tree23 *tree_obj);
 
-Node23 *node_create(bool is_leaf);
+Node23 *node_create(Tree23 *tree, bool is_leaf);
+void node_release(Tree23 *tree, Node23 *node23);
+bool node_reserve(Tree23 *tree, int count);
+Node23Pool *tree_pool(Tree23 *tree);
+void pool_release(Node23Pool *pool);
+void pool_merge(Node23Pool *into, Node23Pool *from);
+void update_count(Node23 *node);
 void node_destroy(Node23 *node23 , Tree23 *tree);
 bool is_empty(Tree23 *tree);
 void insert(Tree23 *tree, void *data, void *key);
@@ -40,7 +68,20 @@ Node23 *recursive_search(Tree23 *tree, Node23 *node, const void *key);
 Node23 *insert_recursive(Tree23 *tree, Node23 *current, void *key, void *data, void **key_up, void **data_up);
 void insert_key_data(Node23 *node, void *key, void *data, Node23 *child, int pos);
 int find_child_index(Tree23 *tree, Node23 *current, void *key);
-Node23 *split_node(Tree23 *tree, Node23 *old_node, void *new_key, void *new_data, Node23 *new_child, void **median_key, void **median_data);
+Node23 *split_node(Tree23 *tree, Node23 *old_node, int insert_idx, void *new_key, void *new_data, Node23 *new_child, void **median_key, void **median_data);
 void realign_children(Node23 *node, int pos, Node23 *child_node);
+bool tree23_bulk_load(Tree23 *tree, void **keys, void **data, int n);
+void bulk_discard(Tree23 *tree, Node23 *node);
+bool delete_tree(Tree23 *tree, const void *key);
+void remove_key_data(Node23 *node, int pos);
+void borrow_from_left(Node23 *parent, int idx);
+void borrow_from_right(Node23 *parent, int idx);
+void merge_children(Tree23 *tree, Node23 *parent, int idx);
+void fix_underflow(Tree23 *tree, Node23 *node);
+int tree23_height(Node23 *node);
+Node23 *join23(Tree23 *tree, Node23 *l, int hl, void *key, void *data, Node23 *r, int hr, int *h);
+void split23(Tree23 *tree, Node23 *node, int h, const void *key, Node23 **l, int *hl, Node23 **r, int *hr);
+void tree23_split(Tree23 *tree, const void *key, Tree23 **left, Tree23 **right);
+Tree23 *tree23_concat(Tree23 *a, Tree23 *b);
 void display(Tree23 *tree_obj);
 void display_tree_recursive(Tree23 *tree, Node23 *node, const char *prefix, int depth);
\ No newline at end of file
@@ -177,7 +177,199 @@ void test_sequential() {
     printf("Sequential test completed.\n\n");
 }
 
-int main() {
+void test_delete() {
+    printf("=== Testing Delete ===\n");
+
+    Tree23 *tree = create_tree(compare_int, print_int, print_int, free_dynamic, free_dynamic);
+    for (int i = 0; i < 10; i++) {
+        int *key = malloc(sizeof(int));
+        int *data = malloc(sizeof(int));
+        *key = i * 5;
+        *data = i * 100;
+        insert(tree, data, key);
+    }
+
+    int delete_keys[] = {20, 0, 45, 7};
+    for (int i = 0; i < 4; i++) {
+        bool removed = delete_tree(tree, &delete_keys[i]);
+        printf("Delete key %d: %s\n", delete_keys[i], removed ? "removed" : "not found");
+    }
+    printf("\nTree structure after deletes:\n");
+    display(tree);
+    printf("\nTree size: %d\n", tree->size);
+
+    free_tree(tree);
+    printf("Delete test completed.\n\n");
+}
+
+// Shuffled 0..n-1 inserted, then deleted in a second shuffle; AVL/main.c runs
+// the same workload so the two delete latencies can be compared.
+void shuffle_keys(int *keys, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+}
+
+void bench_delete(int num_elements) {
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i;
+    }
+    srand(42);
+    shuffle_keys(keys, num_elements);
+    Tree23 *tree = create_tree(compare_int, print_int, print_int, NULL, NULL);
+    for (int i = 0; i < num_elements; i++) {
+        insert(tree, &keys[i], &keys[i]);
+    }
+    int *order = (int *)malloc(sizeof(int) * num_elements); // the tree points into keys[], so shuffle a copy
+    memcpy(order, keys, sizeof(int) * num_elements);
+    shuffle_keys(order, num_elements);
+    clock_t start = clock();
+    for (int i = 0; i < num_elements; i++) {
+        delete_tree(tree, &order[i]);
+    }
+    double delete_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    printf("2-3 tree: %d deletes in %.2f ms (%.1f ns/delete), size after %d\n",
+           num_elements, delete_ms, delete_ms * 1e6 / num_elements, tree->size);
+    free_tree(tree);
+    free(order);
+    free(keys);
+}
+
+void test_bulk_load() {
+    printf("=== Testing Bulk Load ===\n");
+
+    Tree23 *tree = create_tree(compare_int, print_int, print_int, free_dynamic, free_dynamic);
+    void *keys[10];
+    void *values[10];
+    for (int i = 0; i < 10; i++) {
+        int *key = malloc(sizeof(int));
+        int *data = malloc(sizeof(int));
+        *key = i * 5; // same keys as test_sequential
+        *data = i * 100;
+        keys[i] = key;
+        values[i] = data;
+    }
+    bool loaded = tree23_bulk_load(tree, keys, values, 10);
+    printf("Bulk load of 10 sorted keys: %s\n", loaded ? "ok" : "failed");
+    display(tree);
+    printf("\nTree size: %d\n", tree->size);
+
+    free_tree(tree);
+    printf("Bulk load test completed.\n\n");
+}
+
+void bench_bulk_load(int num_elements) {
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    void **ptrs = (void **)malloc(sizeof(void *) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i;
+        ptrs[i] = &keys[i];
+    }
+    Tree23 *inserted = create_tree(compare_int, print_int, print_int, NULL, NULL);
+    clock_t start = clock();
+    for (int i = 0; i < num_elements; i++) {
+        insert(inserted, &keys[i], &keys[i]);
+    }
+    double insert_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    Tree23 *loaded = create_tree(compare_int, print_int, print_int, NULL, NULL);
+    start = clock();
+    tree23_bulk_load(loaded, ptrs, ptrs, num_elements);
+    double bulk_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("2-3 tree: sorted load of %d, insert %.2f ms, bulk %.2f ms\n", num_elements, insert_ms, bulk_ms);
+    free_tree(inserted);
+    free_tree(loaded);
+    free(ptrs);
+    free(keys);
+}
+
+void test_split_concat() {
+    printf("=== Testing Split / Concat ===\n");
+
+    Tree23 *tree = create_tree(compare_int, print_int, print_int, free_dynamic, free_dynamic);
+    for (int i = 0; i < 10; i++) {
+        int *key = malloc(sizeof(int));
+        int *data = malloc(sizeof(int));
+        *key = i * 5;
+        *data = i * 100;
+        insert(tree, data, key);
+    }
+    int pivot = 22;
+    Tree23 *left, *right;
+    tree23_split(tree, &pivot, &left, &right);
+    printf("Split at %d: left size %d, right size %d\n", pivot, left->size, right->size);
+    display(left);
+    display(right);
+
+    tree = tree23_concat(left, right);
+    printf("\nConcatenated back, size %d:\n", tree->size);
+    display(tree);
+
+    free_tree(tree);
+    printf("Split / concat test completed.\n\n");
+}
+
+// Cuts a tree into shards at evenly spaced keys and joins them back, against
+// rebuilding each shard and the merged tree by bulk load.
+void bench_split_concat(int num_elements) {
+    const int shards = 16;
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    void **ptrs = (void **)malloc(sizeof(void *) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i;
+        ptrs[i] = &keys[i];
+    }
+    Tree23 *tree = create_tree(compare_int, print_int, print_int, NULL, NULL);
+    tree23_bulk_load(tree, ptrs, ptrs, num_elements);
+
+    Tree23 *parts[16];
+    clock_t start = clock();
+    for (int s = 1; s < shards; s++) {
+        int pivot = (int)((long)num_elements * s / shards);
+        tree23_split(tree, &pivot, &parts[s - 1], &tree);
+    }
+    parts[shards - 1] = tree;
+    double split_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int s = shards - 1; s > 0; s--) {
+        parts[s - 1] = tree23_concat(parts[s - 1], parts[s]);
+    }
+    double concat_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    int merged = parts[0]->size;
+    free_tree(parts[0]);
+
+    start = clock();
+    for (int s = 0; s < shards; s++) {
+        int lo = (int)((long)num_elements * s / shards);
+        int hi = (int)((long)num_elements * (s + 1) / shards);
+        Tree23 *shard = create_tree(compare_int, print_int, print_int, NULL, NULL);
+        tree23_bulk_load(shard, ptrs + lo, ptrs + lo, hi - lo);
+        free_tree(shard);
+    }
+    Tree23 *rebuilt = create_tree(compare_int, print_int, print_int, NULL, NULL);
+    tree23_bulk_load(rebuilt, ptrs, ptrs, num_elements);
+    double rebuild_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("2-3 tree: %d shards of %d, split %.3f ms, concat %.3f ms (size %d), rebuild %.2f ms\n",
+           shards, num_elements, split_ms, concat_ms, merged, rebuild_ms);
+    free_tree(rebuilt);
+    free(ptrs);
+    free(keys);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) { // ./gen_23tree bench [elements]
+        int num_elements = argc > 2 ? atoi(argv[2]) : 1000000;
+        bench_delete(num_elements);
+        bench_bulk_load(num_elements);
+        bench_split_concat(num_elements);
+        return 0;
+    }
     printf("2-3 Tree Implementation Test\n");
     printf("============================\n\n");
     
@@ -185,6 +377,9 @@ int main() {
     test_random_data();
     test_sequential();
     test_edge_cases();
+    test_delete();
+    test_bulk_load();
+    test_split_concat();
     
     printf("All tests completed successfully!\n");
     return 0;
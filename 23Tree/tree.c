@@ -2,7 +2,13 @@
 
 Tree23 *create_tree(int (*compare_func)(const void *, const void *), void (*print_key)(const void *),void (*print_data)(const void *),void (*free_data)(void *),void (*free_key)(void *));
 void free_tree(Tree23 *tree_obj);
-Node23 *node_create(bool is_leaf);
+Node23 *node_create(Tree23 *tree, bool is_leaf);
+void node_release(Tree23 *tree, Node23 *node23);
+bool node_reserve(Tree23 *tree, int count);
+Node23Pool *tree_pool(Tree23 *tree);
+void pool_release(Node23Pool *pool);
+void pool_merge(Node23Pool *into, Node23Pool *from);
+void update_count(Node23 *node);
 void node_destroy(Node23 *node23 , Tree23 *tree);
 bool is_empty(Tree23 *tree);
 void insert(Tree23 *tree, void *data, void *key);
@@ -11,8 +17,21 @@ Node23 *recursive_search(Tree23 *tree, Node23 *node, const void *key);
 Node23 *insert_recursive(Tree23 *tree, Node23 *current, void *key, void *data, void **key_up, void **data_up);
 void insert_key_data(Node23 *node, void *key, void *data, Node23 *child, int pos);
 int find_child_index(Tree23 *tree, Node23 *current, void *key);
-Node23 *split_node(Tree23 *tree, Node23 *old_node, void *new_key, void *new_data, Node23 *new_child, void **median_key, void **median_data);
+Node23 *split_node(Tree23 *tree, Node23 *old_node, int insert_idx, void *new_key, void *new_data, Node23 *new_child, void **median_key, void **median_data);
 void realign_children(Node23 *node, int pos, Node23 *child_node);
+bool tree23_bulk_load(Tree23 *tree, void **keys, void **data, int n);
+void bulk_discard(Tree23 *tree, Node23 *node);
+bool delete_tree(Tree23 *tree, const void *key);
+void remove_key_data(Node23 *node, int pos);
+void borrow_from_left(Node23 *parent, int idx);
+void borrow_from_right(Node23 *parent, int idx);
+void merge_children(Tree23 *tree, Node23 *parent, int idx);
+void fix_underflow(Tree23 *tree, Node23 *node);
+int tree23_height(Node23 *node);
+Node23 *join23(Tree23 *tree, Node23 *l, int hl, void *key, void *data, Node23 *r, int hr, int *h);
+void split23(Tree23 *tree, Node23 *node, int h, const void *key, Node23 **l, int *hl, Node23 **r, int *hr);
+void tree23_split(Tree23 *tree, const void *key, Tree23 **left, Tree23 **right);
+Tree23 *tree23_concat(Tree23 *a, Tree23 *b);
 void display(Tree23 *tree_obj);
 void display_tree_recursive(Tree23 *tree, Node23 *node, const char *prefix, int depth);
 
@@ -33,20 +52,132 @@ Tree23 *create_tree(int (*compare_func)(const void *, const void *), void (*prin
     tree_obj->print_data = print_data;
     tree_obj->free_data = free_data;
     tree_obj->free_key = free_key;
+    tree_obj->pool = NULL;
     return tree_obj;
 }
 
-Node23* node_create(bool is_leaf) {
-    Node23 *node23 = (Node23 *)malloc(sizeof(Node23));
-    node23->keys = (void **)calloc(2, sizeof(void *));
-    node23->data = (void **)calloc(2, sizeof(void *));
-    node23->children = (Node23 **)calloc(3, sizeof(Node23 *));
+// the tree's pool, created on first use; a pool merged away since the last
+// call is swapped for the one that now holds its blocks
+Node23Pool *tree_pool(Tree23 *tree) {
+    Node23Pool *pool = tree->pool;
+    if (!pool) {
+        pool = (Node23Pool *)calloc(1, sizeof(Node23Pool));
+        if (!pool) {
+            perror("Failed to allocate memory for node pool");
+            return NULL;
+        }
+        pool->refs = 1;
+        tree->pool = pool;
+    } else if (pool->merged_into) {
+        Node23Pool *target = pool->merged_into;
+        while (target->merged_into) target = target->merged_into;
+        target->refs++;
+        pool_release(pool);
+        tree->pool = target;
+    }
+    return tree->pool;
+}
+
+void pool_release(Node23Pool *pool) {
+    while (pool && --pool->refs == 0) {
+        Node23Pool *next = pool->merged_into;
+        Node23Block *block = pool->blocks;
+        while (block) {
+            Node23Block *next_block = block->next;
+            free(block);
+            block = next_block;
+        }
+        free(pool);
+        pool = next;
+    }
+}
+
+// O(1): both lists are spliced at their tails
+void pool_merge(Node23Pool *into, Node23Pool *from) {
+    if (from == into) return;
+    if (from->blocks) {
+        from->blocks_tail->next = into->blocks;
+        if (!into->blocks) into->blocks_tail = from->blocks_tail;
+        into->blocks = from->blocks;
+    }
+    if (from->free_nodes) {
+        from->free_tail->parent = into->free_nodes;
+        if (!into->free_nodes) into->free_tail = from->free_tail;
+        into->free_nodes = from->free_nodes;
+    }
+    from->blocks = from->blocks_tail = NULL;
+    from->free_nodes = from->free_tail = NULL;
+    from->merged_into = into;
+    into->refs++;
+}
+
+Node23* node_create(Tree23 *tree, bool is_leaf) {
+    Node23Pool *pool = tree_pool(tree);
+    if (!pool) return NULL;
+    Node23 *node23 = pool->free_nodes;
+    if (node23) {
+        pool->free_nodes = node23->parent;
+        if (!pool->free_nodes) pool->free_tail = NULL;
+    } else {
+        Node23Block *block = pool->blocks;
+        if (!block || block->used == NODE23_BLOCK) {
+            block = (Node23Block *)malloc(sizeof(Node23Block));
+            if (!block) {
+                perror("Failed to allocate memory for node block");
+                return NULL;
+            }
+            block->used = 0;
+            block->next = pool->blocks;
+            if (!pool->blocks) pool->blocks_tail = block;
+            pool->blocks = block;
+        }
+        node23 = &block->nodes[block->used++];
+    }
+    node23->keys[0] = node23->keys[1] = NULL;
+    node23->data[0] = node23->data[1] = NULL;
+    node23->children[0] = node23->children[1] = node23->children[2] = NULL;
     node23->key_count = 0;
+    node23->count = 0;
     node23->parent = NULL;
     node23->is_leaf = is_leaf;
     return node23;
 }
 
+void node_release(Tree23 *tree, Node23 *node23) {
+    Node23Pool *pool = tree_pool(tree);
+    node23->parent = pool->free_nodes;
+    if (!pool->free_nodes) pool->free_tail = node23;
+    pool->free_nodes = node23;
+}
+
+// Makes sure the next count node_create calls are served from the freelist,
+// so a multi-step restructure can claim its nodes before it changes anything.
+bool node_reserve(Tree23 *tree, int count) {
+    Node23 *taken = NULL; // chained through parent, as on the freelist
+    int got = 0;
+    for (; got < count; got++) {
+        Node23 *node23 = node_create(tree, true);
+        if (!node23) break;
+        node23->parent = taken;
+        taken = node23;
+    }
+    while (taken) {
+        Node23 *next = taken->parent;
+        node_release(tree, taken);
+        taken = next;
+    }
+    return got == count;
+}
+
+void update_count(Node23 *node) {
+    node->count = node->key_count;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->key_count; i++) {
+            node->count += node->children[i]->count;
+        }
+    }
+}
+
 void node_destroy(Node23 *node23 , Tree23 *tree) {
     if(!node23) return;
     for (int i = 0; i < node23->key_count; i++) {
@@ -62,15 +193,21 @@ void node_destroy(Node23 *node23 , Tree23 *tree) {
             node_destroy(node23->children[i], tree);
         }
     }
-    free(node23->data);
-    free(node23->keys);
-    free(node23->children);
-    free(node23);
+    node_release(tree, node23);
 }
 
 void free_tree(Tree23 *tree_obj){
     if (!tree_obj) return;
-    node_destroy(tree_obj->root, tree_obj);
+    if (!tree_obj->pool) {
+        free(tree_obj);
+        return;
+    }
+    Node23Pool *pool = tree_pool(tree_obj);
+    // nodes themselves go with their blocks, unless another tree still shares them
+    if (pool->refs > 1 || tree_obj->free_key || tree_obj->free_data) {
+        node_destroy(tree_obj->root, tree_obj);
+    }
+    pool_release(pool);
     free(tree_obj);
 }
 
@@ -122,6 +259,7 @@ void insert_key_data(Node23 *node, void *key, void *data, Node23 *child, int pos
         child->parent = node;
     }
     node->key_count++;
+    update_count(node);
 }
 
 int find_child_index(Tree23 *tree,Node23 *current,void *key) {
@@ -134,15 +272,11 @@ int find_child_index(Tree23 *tree,Node23 *current,void *key) {
     }
 }
 
-Node23 *split_node(Tree23 *tree, Node23 *old_node, void *new_key, void *new_data, Node23 *new_child, void **median_key, void **median_data) {
+Node23 *split_node(Tree23 *tree, Node23 *old_node, int insert_idx, void *new_key, void *new_data, Node23 *new_child, void **median_key, void **median_data) {
     // temp node container
     void *all_keys[3];
     void *all_data[3];
     Node23 *all_children[4];
-    int insert_idx = 0;
-    while (insert_idx < 2 && tree->compare(new_key, old_node->keys[insert_idx]) > 0) {
-        insert_idx++;
-    }
     int j = 0;
     for (int i = 0; i < 3; i++) {
         if (i == insert_idx) {
@@ -180,7 +314,7 @@ Node23 *split_node(Tree23 *tree, Node23 *old_node, void *new_key, void *new_data
         if (old_node->children[1]) old_node->children[1]->parent = old_node;
     }
 
-    Node23 *new_node = node_create(old_node->is_leaf);
+    Node23 *new_node = node_create(tree, old_node->is_leaf);
     new_node->parent = old_node->parent;
     new_node->keys[0] = all_keys[2];
     new_node->data[0] = all_data[2];
@@ -191,7 +325,8 @@ Node23 *split_node(Tree23 *tree, Node23 *old_node, void *new_key, void *new_data
         if (new_node->children[0]) new_node->children[0]->parent = new_node;
         if (new_node->children[1]) new_node->children[1]->parent = new_node;
     }
-
+    update_count(old_node);
+    update_count(new_node);
     return new_node;
 }
 
@@ -207,12 +342,15 @@ Node23 *insert_recursive(Tree23 *tree, Node23 *current, void *key, void *data, v
     }
     int pos;
     if(current->is_leaf) {
-        pos = tree->compare(key , current->keys[0]) < 0 ? 0 :current->key_count;
+        pos = 0;
+        while (pos < current->key_count && tree->compare(key, current->keys[pos]) >= 0) {
+            pos++; // equal keys go right, as in find_child_index
+        }
         if(current->key_count < 2) { // case 1 (not full node -> simple insert)
             insert_key_data(current , key , data , NULL , pos);
             return NULL; // no split
         } else {
-            Node23 *new_node = split_node(tree , current , key , data , NULL , key_up , data_up);
+            Node23 *new_node = split_node(tree , current , pos , key , data , NULL , key_up , data_up);
             return new_node; // case 2 (full node -> split)
         }
     }
@@ -222,16 +360,17 @@ Node23 *insert_recursive(Tree23 *tree, Node23 *current, void *key, void *data, v
     void *mid_data = NULL; // to pass up to parent
     Node23 *split_child = insert_recursive(tree , current->children[child_idx] , key , data , &mid_key , &mid_data);
     if(split_child == NULL) {
+        current->count++;
         return NULL; // data inserted below without spliit
     }
     split_child->parent = current;
     if(current->key_count < 2) {
-        pos = tree->compare(mid_key , current->keys[0]) < 0 ? 0 :current->key_count; // case 3 simple insert (space found)
-        insert_key_data(current , mid_key , mid_data , split_child , pos);
-        realign_children(current , pos , split_child);
+        // case 3 simple insert (space found): the child's median sits where we descended
+        insert_key_data(current , mid_key , mid_data , split_child , child_idx);
+        realign_children(current , child_idx , split_child);
         return NULL; // no split
     } else {
-        Node23 *new_node =  split_node(tree , current , mid_key , mid_data, split_child , key_up , data_up); // case 4 (split current with split_child)
+        Node23 *new_node =  split_node(tree , current , child_idx , mid_key , mid_data, split_child , key_up , data_up); // case 4 (split current with split_child)
         return new_node;
     }
 }
@@ -240,16 +379,17 @@ void insert(Tree23 *tree, void *data , void *key) {
     void *mid_key = NULL;
     void *mid_data = NULL;
     if (tree->root == NULL) {
-        tree->root = node_create(true);
+        tree->root = node_create(tree, true);
         tree->root->keys[0] = key;
         tree->root->data[0] = data;
         tree->root->key_count = 1;
+        tree->root->count = 1;
         tree->size++;
         return;
     }
     Node23 *split_node = insert_recursive(tree, tree->root, key, data, &mid_key, &mid_data);
     if(split_node != NULL)  { // split at root (handle here)
-        Node23 *new_root = node_create(false);
+        Node23 *new_root = node_create(tree, false);
         new_root->keys[0] = mid_key;
         new_root->data[0] = mid_data;
         new_root->key_count = 1;
@@ -257,11 +397,476 @@ void insert(Tree23 *tree, void *data , void *key) {
         new_root->children[1] = split_node;
         tree->root->parent = new_root;
         split_node->parent = new_root;
+        update_count(new_root);
         tree->root = new_root;
     }
     tree->size++;
 } 
 
+// on allocation failure: hands the nodes built so far back to the pool, the
+// keys and data still belong to the caller
+void bulk_discard(Tree23 *tree, Node23 *node) {
+    if (!node) return;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->key_count; i++) {
+            bulk_discard(tree, node->children[i]);
+        }
+    }
+    node_release(tree, node);
+}
+
+// O(n) construction from keys sorted by tree->compare (data may be NULL),
+// one level at a time from the leaves up. A level of e entries becomes k
+// nodes separated by k-1 entries that move up as the next level's entries,
+// leaving e+1-k to share out, as evenly as possible, among the k nodes. With
+// k = ceil((e+1)/3), 3k >= e+1 keeps that at most 2k and 3k <= e+3 keeps it
+// at least k (e = 1 or 2 is a single node), so every node gets one or two keys: a valid 2- or 3-node. An
+// internal node with c keys takes c+1 children, so one level consumes
+// exactly the e+1 nodes built below it, and all leaves share a depth.
+// Returns false, leaving the tree untouched, if it is not empty, the keys are
+// unsorted or memory runs out.
+bool tree23_bulk_load(Tree23 *tree, void **keys, void **data, int n) {
+    if (tree->root || n <= 0) return n == 0 && !tree->root;
+    for (int i = 1; i < n; i++) {
+        if (tree->compare(keys[i-1], keys[i]) > 0) return false;
+    }
+    int nodes = (n + 3) / 3;
+    void **level_keys = (void **)malloc(sizeof(void *) * nodes); // entries moving up a level
+    void **level_data = (void **)malloc(sizeof(void *) * nodes);
+    Node23 **level_nodes = (Node23 **)malloc(sizeof(Node23 *) * nodes);
+    if (!level_keys || !level_data || !level_nodes) {
+        perror("Failed to allocate memory for bulk load");
+        free(level_keys);
+        free(level_data);
+        free(level_nodes);
+        return false;
+    }
+
+    void **src_keys = keys;
+    void **src_data = data;
+    int entries = n;
+    Node23 **children = NULL; // NULL while building leaves
+    bool ok = true;
+    while (true) {
+        nodes = (entries + 3) / 3; // ceil((entries + 1) / 3)
+        int share = entries - (nodes - 1); // entries kept in nodes, the rest go up
+        int pos = 0;
+        int child = 0;
+        int built = 0;
+        for (int i = 0; i < nodes; i++) {
+            int count = share / nodes + (i < share % nodes); // 1 or 2, see above
+            Node23 *node = node_create(tree, children == NULL);
+            if (!node) {
+                ok = false;
+                break;
+            }
+            for (int j = 0; j < count; j++, pos++) {
+                node->keys[j] = src_keys[pos];
+                node->data[j] = src_data ? src_data[pos] : NULL;
+            }
+            if (children) {
+                for (int j = 0; j <= count; j++, child++) {
+                    node->children[j] = children[child];
+                    children[child]->parent = node;
+                }
+            }
+            node->key_count = count;
+            update_count(node);
+            level_nodes[built++] = node;
+            if (i < nodes - 1) { // the entry between this node and the next moves up
+                level_keys[i] = src_keys[pos];
+                level_data[i] = src_data ? src_data[pos] : NULL;
+                pos++;
+            }
+        }
+        if (!ok) {
+            for (int i = 0; i < built; i++) bulk_discard(tree, level_nodes[i]);
+            if (children) { // the lower level's nodes this level had not reached yet
+                for (int j = child; j < entries + 1; j++) bulk_discard(tree, children[j]);
+            }
+            break;
+        }
+        if (nodes == 1) {
+            tree->root = level_nodes[0];
+            break;
+        }
+        // the level above overwrites these arrays in place: its node i reads
+        // entries and lower nodes from index 2i on, never behind i
+        src_keys = level_keys;
+        src_data = level_data;
+        entries = nodes - 1;
+        children = level_nodes;
+    }
+    free(level_keys);
+    free(level_data);
+    free(level_nodes);
+    if (!ok) return false;
+    tree->size = n;
+    return true;
+}
+
+// drop keys[pos]/data[pos] and, in an internal node, children[pos+1]
+void remove_key_data(Node23 *node, int pos) {
+    if (pos == 0 && node->key_count == 2) {
+        node->keys[0] = node->keys[1];
+        node->data[0] = node->data[1];
+        if (!node->is_leaf) node->children[1] = node->children[2];
+    }
+    node->key_count--;
+    node->keys[node->key_count] = NULL;
+    node->data[node->key_count] = NULL;
+    if (!node->is_leaf) node->children[node->key_count + 1] = NULL;
+}
+
+// redistribution: the empty children[idx] takes the separator on its left,
+// the 3-node on the left gives up its last key (and last child) to the parent
+void borrow_from_left(Node23 *parent, int idx) {
+    Node23 *node = parent->children[idx];
+    Node23 *left = parent->children[idx-1];
+    node->keys[0] = parent->keys[idx-1];
+    node->data[0] = parent->data[idx-1];
+    if (!node->is_leaf) {
+        node->children[1] = node->children[0];
+        node->children[0] = left->children[2];
+        node->children[0]->parent = node;
+    }
+    node->key_count = 1;
+    parent->keys[idx-1] = left->keys[1];
+    parent->data[idx-1] = left->data[1];
+    remove_key_data(left, 1);
+    update_count(left);
+    update_count(node);
+}
+
+// redistribution from the 3-node on the right
+void borrow_from_right(Node23 *parent, int idx) {
+    Node23 *node = parent->children[idx];
+    Node23 *right = parent->children[idx+1];
+    node->keys[0] = parent->keys[idx];
+    node->data[0] = parent->data[idx];
+    if (!node->is_leaf) {
+        node->children[1] = right->children[0];
+        node->children[1]->parent = node;
+        right->children[0] = right->children[1];
+        right->children[1] = right->children[2];
+        right->children[2] = NULL;
+    }
+    node->key_count = 1;
+    parent->keys[idx] = right->keys[0];
+    parent->data[idx] = right->data[0];
+    right->keys[0] = right->keys[1];
+    right->data[0] = right->data[1];
+    right->keys[1] = NULL;
+    right->data[1] = NULL;
+    right->key_count = 1;
+    update_count(right);
+    update_count(node);
+}
+
+// fusion: separator idx and children[idx+1] fold into children[idx], one of
+// the two being empty, and the right node goes back to the pool
+void merge_children(Tree23 *tree, Node23 *parent, int idx) {
+    Node23 *left = parent->children[idx];
+    Node23 *right = parent->children[idx+1];
+    int base = left->key_count;
+    left->keys[base] = parent->keys[idx];
+    left->data[base] = parent->data[idx];
+    for (int i = 0; i < right->key_count; i++) {
+        left->keys[base + 1 + i] = right->keys[i];
+        left->data[base + 1 + i] = right->data[i];
+    }
+    if (!left->is_leaf) {
+        for (int i = 0; i <= right->key_count; i++) {
+            left->children[base + 1 + i] = right->children[i];
+            right->children[i]->parent = left;
+        }
+    }
+    left->key_count += 1 + right->key_count;
+    update_count(left); // the parent's total is unchanged
+    remove_key_data(parent, idx); // also drops children[idx+1]
+    node_release(tree, right);
+}
+
+// An emptied node is refilled from a 3-node sibling if it has one, otherwise
+// fused with a 2-node sibling, which may empty the parent in turn. An empty
+// root collapses onto its only child.
+void fix_underflow(Tree23 *tree, Node23 *node) {
+    while (node != tree->root && node->key_count == 0) {
+        Node23 *parent = node->parent;
+        int idx = 0;
+        while (parent->children[idx] != node) idx++;
+        if (idx > 0 && parent->children[idx-1]->key_count == 2) {
+            borrow_from_left(parent, idx);
+            return;
+        }
+        if (idx < parent->key_count && parent->children[idx+1]->key_count == 2) {
+            borrow_from_right(parent, idx);
+            return;
+        }
+        merge_children(tree, parent, idx > 0 ? idx - 1 : idx);
+        node = parent;
+    }
+    Node23 *root = tree->root;
+    if (root->key_count == 0) {
+        tree->root = root->is_leaf ? NULL : root->children[0];
+        if (tree->root) tree->root->parent = NULL;
+        node_release(tree, root);
+    }
+}
+
+// Removes one entry matching key, freeing its key and data through the tree's
+// free callbacks. Nodes emptied along the way return to the pool's freelist.
+bool delete_tree(Tree23 *tree, const void *key) {
+    Node23 *node = tree->root;
+    int idx = 0;
+    while (node) {
+        int cmp = tree->compare(key, node->keys[0]);
+        idx = 0;
+        if (cmp > 0 && node->key_count == 2) {
+            cmp = tree->compare(key, node->keys[1]);
+            idx = 1;
+        }
+        if (cmp == 0) break;
+        if (node->is_leaf) return false;
+        node = node->children[idx + (cmp > 0)];
+    }
+    if (!node) return false;
+    if (tree->free_key && node->keys[idx]) tree->free_key(node->keys[idx]);
+    if (tree->free_data && node->data[idx]) tree->free_data(node->data[idx]);
+    if (!node->is_leaf) { // swap in the predecessor, then remove it from its leaf
+        Node23 *leaf = node->children[idx];
+        while (!leaf->is_leaf) leaf = leaf->children[leaf->key_count];
+        node->keys[idx] = leaf->keys[leaf->key_count - 1];
+        node->data[idx] = leaf->data[leaf->key_count - 1];
+        node = leaf;
+        idx = leaf->key_count - 1;
+    }
+    remove_key_data(node, idx);
+    for (Node23 *up = node; up; up = up->parent) up->count--;
+    tree->size--;
+    fix_underflow(tree, node);
+    return true;
+}
+
+int tree23_height(Node23 *node) {
+    int h = 0;
+    for (; node; node = node->is_leaf ? NULL : node->children[0]) h++;
+    return h;
+}
+
+// Joins l (height hl) and r (height hr), either possibly empty (height 0),
+// around an entry ordered between them. Equal heights get a new root; otherwise
+// the shorter tree is hung off the spine of the taller one at the level above
+// its own height, and an overflowing spine node splits upwards as in insert.
+// O(|hl - hr| + 1): the attach point is |hl - hr| levels below the taller
+// root, and both the splits and the count refresh after them climb back up
+// that same spine, nothing else changes size. It creates at most |hl - hr| + 1
+// nodes, which its callers reserve beforehand, so node_create cannot fail here.
+Node23 *join23(Tree23 *tree, Node23 *l, int hl, void *key, void *data, Node23 *r, int hr, int *h) {
+    if (hl == hr) {
+        Node23 *root = node_create(tree, hl == 0);
+        if (!root) return NULL;
+        root->keys[0] = key;
+        root->data[0] = data;
+        root->key_count = 1;
+        if (hl > 0) {
+            root->children[0] = l;
+            root->children[1] = r;
+            l->parent = r->parent = root;
+        }
+        update_count(root);
+        *h = hl + 1;
+        return root;
+    }
+    Node23 *node, *child;
+    int pos;
+    if (hl > hr) { // r goes right of key, on l's right spine
+        node = l;
+        for (int i = hl; i > hr + 1; i--) node = node->children[node->key_count];
+        pos = node->key_count;
+        child = r;
+        *h = hl;
+    } else { // l goes left of key, on r's left spine
+        node = r;
+        for (int i = hr; i > hl + 1; i--) node = node->children[0];
+        pos = 0;
+        child = NULL;
+        if (l) { // l takes the first slot and the old first child moves right of key
+            child = node->children[0];
+            node->children[0] = l;
+            l->parent = node;
+        }
+        *h = hr;
+    }
+    while (node->key_count == 2) {
+        void *mid_key, *mid_data;
+        Node23 *split = split_node(tree, node, pos, key, data, child, &mid_key, &mid_data);
+        Node23 *parent = node->parent;
+        if (!parent) { // split at root
+            Node23 *root = node_create(tree, false);
+            root->keys[0] = mid_key;
+            root->data[0] = mid_data;
+            root->key_count = 1;
+            root->children[0] = node;
+            root->children[1] = split;
+            node->parent = split->parent = root;
+            update_count(root);
+            (*h)++;
+            return root;
+        }
+        pos = 0;
+        while (parent->children[pos] != node) pos++;
+        key = mid_key;
+        data = mid_data;
+        child = split;
+        node = parent;
+    }
+    insert_key_data(node, key, data, child, pos);
+    while (node->parent) {
+        node = node->parent;
+        update_count(node);
+    }
+    return node;
+}
+
+// Splits the subtree under node (height h) into the entries ordered before key
+// and the rest, each returned as a standalone subtree with its height. The path
+// to key is cut at every level: the whole subtrees and separators on either
+// side of it are joined onto the pieces coming back from below. Each join
+// costs the height gap between its two trees (count refresh included, see
+// join23), and as the piece from below only grows the gaps telescope to at
+// most h plus one per join, so a split is O(h) in all (about 3h count updates
+// measured). node is reused for
+// the 2-node left over when a 3-node is cut at its edge, or released.
+void split23(Tree23 *tree, Node23 *node, int h, const void *key, Node23 **l, int *hl, Node23 **r, int *hr) {
+    int kc = node->key_count;
+    void *keys[2] = {node->keys[0], node->keys[1]};
+    void *data[2] = {node->data[0], node->data[1]};
+    Node23 *kids[3] = {node->children[0], node->children[1], node->children[2]};
+    int i = 0;
+    while (i < kc && tree->compare(keys[i], key) < 0) i++;
+    Node23 *lc = NULL, *rc = NULL;
+    int hlc = 0, hrc = 0;
+    if (!node->is_leaf) {
+        for (int j = 0; j <= kc; j++) kids[j]->parent = NULL;
+        split23(tree, kids[i], h - 1, key, &lc, &hlc, &rc, &hrc);
+    }
+    Node23 *spare = NULL; // node rebuilt as a 2-node over kids[a], kids[a+1]
+    int a = i == 2 ? 0 : 1;
+    if (i == 2 || (i == 0 && kc == 2)) {
+        spare = node;
+        spare->keys[0] = keys[a];
+        spare->data[0] = data[a];
+        spare->keys[1] = spare->data[1] = NULL;
+        spare->key_count = 1;
+        spare->children[0] = kids[a];
+        spare->children[1] = kids[a + 1];
+        spare->children[2] = NULL;
+        spare->parent = NULL;
+        if (!spare->is_leaf) kids[a]->parent = kids[a + 1]->parent = spare;
+        update_count(spare);
+    } else {
+        node_release(tree, node);
+    }
+
+    if (i == 0) {
+        *l = lc;
+        *hl = hlc;
+    } else if (i == 1) {
+        *l = join23(tree, kids[0], h - 1, keys[0], data[0], lc, hlc, hl);
+    } else {
+        *l = join23(tree, spare, h, keys[1], data[1], lc, hlc, hl);
+    }
+    if (i == kc) {
+        *r = rc;
+        *hr = hrc;
+    } else if (kc - i == 1) {
+        *r = join23(tree, rc, hrc, keys[i], data[i], kids[i + 1], h - 1, hr);
+    } else {
+        *r = join23(tree, rc, hrc, keys[0], data[0], spare, h, hr);
+    }
+}
+
+// Cuts tree in two: *left (reusing tree) keeps the entries ordered before key,
+// *right gets key and everything after it. No entry is copied or freed, the
+// nodes are regrouped in O(log n). The two trees share the node pool, which
+// lives until both are freed. Each side's joins create at most 3h nodes (the
+// gaps sum to h plus one per join, see split23), and those are reserved up
+// front: on allocation failure tree is left whole in *left and *right is NULL.
+void tree23_split(Tree23 *tree, const void *key, Tree23 **left, Tree23 **right) {
+    *left = tree;
+    *right = create_tree(tree->compare, tree->print_key, tree->print_data, tree->free_data, tree->free_key);
+    if (!*right) return;
+    if (!tree->root) return;
+    int h = tree23_height(tree->root);
+    if (!node_reserve(tree, 6 * h)) {
+        free_tree(*right);
+        *right = NULL;
+        return;
+    }
+    Node23Pool *pool = tree_pool(tree);
+    pool->refs++;
+    (*right)->pool = pool;
+    Node23 *l, *r;
+    int hl, hr;
+    split23(tree, tree->root, h, key, &l, &hl, &r, &hr);
+    tree->root = l;
+    tree->size = l ? l->count : 0;
+    (*right)->root = r;
+    (*right)->size = r ? r->count : 0;
+}
+
+// Appends b to a, whose entries must all order before or equal to b's. The
+// last entry of a is detached to stand between the two and b's root is joined
+// to a's spine (or the other way round), O(log n). b's pool is merged into a's.
+// Consumes b and returns a. The join's nodes (one per level of the taller tree
+// plus a root) are reserved first, so misordered trees, which get a warning,
+// and allocation failure both return NULL with a and b untouched.
+Tree23 *tree23_concat(Tree23 *a, Tree23 *b) {
+    if (!b->root) {
+        free_tree(b);
+        return a;
+    }
+    if (!a->root) { // adopt b's nodes wholesale
+        Node23Pool *pool = a->pool;
+        a->pool = b->pool;
+        b->pool = pool;
+        a->root = b->root;
+        a->size = b->size;
+        b->root = NULL;
+        b->size = 0;
+        free_tree(b);
+        return a;
+    }
+    Node23 *last = a->root;
+    while (!last->is_leaf) last = last->children[last->key_count];
+    Node23 *first = b->root;
+    while (!first->is_leaf) first = first->children[0];
+    if (a->compare(last->keys[last->key_count - 1], first->keys[0]) > 0) {
+        printf("Warning: tree23_concat needs every key of the first tree <= the second.\n");
+        return NULL;
+    }
+    int ha = tree23_height(a->root);
+    int hb = tree23_height(b->root);
+    if (!node_reserve(a, (ha > hb ? ha : hb) + 1)) return NULL;
+    pool_merge(tree_pool(a), tree_pool(b));
+
+    int idx = last->key_count - 1;
+    void *key = last->keys[idx];
+    void *data = last->data[idx];
+    remove_key_data(last, idx);
+    for (Node23 *up = last; up; up = up->parent) up->count--;
+    fix_underflow(a, last);
+    int h;
+    Node23 *root = join23(a, a->root, tree23_height(a->root), key, data, b->root, hb, &h);
+    a->root = root;
+    a->size = root->count;
+    b->root = NULL;
+    b->size = 0;
+    free_tree(b);
+    return a;
+}
+
 void display(Tree23 *tree_obj) {
     if (is_empty(tree_obj) || !tree_obj->root) {
         printf("Tree is empty.\n");
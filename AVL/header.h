@@ -6,24 +6,78 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define AVL_MAX_HEIGHT 64 // an AVL tree of 2^31 nodes is at most ~45 high
+#define ITER_MAX_DEPTH AVL_MAX_HEIGHT // cursor path, never outgrown by a balanced tree
+
+#define SEARCH_BATCH_GROUP 16 // lookups advanced in lockstep by search_batch
+#define PARALLEL_BUILD_MIN (1 << 20) // build_tree_from_array sorts and builds on all cores from here
+#define PARALLEL_SORT_CUTOFF 16384 // smaller sort/merge/build ranges stay on one thread
+#define SET_OP_FORK_HEIGHT 14 // set operations fork only on subtrees at least this tall
 
 typedef struct node_struct {
     void *data;
     struct node_struct *left;
     struct node_struct *right;
     int height; 
+#ifdef AVL_ORDER_STATS
+    int count; // nodes in this subtree, kept by update_height
+#endif
 } node;
 
+typedef struct node_block_struct {
+    struct node_block_struct *next;
+    int used;
+    node nodes[];
+} node_block;
+
+typedef struct node_arena_struct {
+    node_block *blocks;
+    node *free_list; // released nodes, chained through ->left
+    int nodes_per_block;
+} node_arena;
+
 typedef struct tree_struct {
     int size;
     int (*compare)(const void *data1, const void *data2);
     void (*print_func)(const void *data);
     void (*free_data)(void *); 
     node *root;
+    node_arena *arena; // NULL -> nodes come from malloc
 } tree;
 
+// In-order cursor with O(height) state. path[0..depth) runs from the root to
+// current. If the path outgrows ITER_MAX_DEPTH the cursor keeps going by
+// keyed successor/predecessor searches from the root instead.
+typedef struct tree_iter_struct {
+    const tree *tree_obj;
+    node *current; // NULL once the cursor runs off either end
+    int depth;
+    bool overflow;
+    node *path[ITER_MAX_DEPTH];
+} tree_iter;
+
+// Read-only snapshot: keys in Eytzinger (BFS) order in one allocation.
+// keys[1] is the root, keys[2k] / keys[2k+1] are the children of keys[k].
+// keys starts on a cache line, so the 8 slots keys[8k..8k+7] (the
+// descendants of k three levels down) fill exactly one line.
+typedef struct frozen_tree_struct {
+    int size;
+    int (*compare)(const void *data1, const void *data2);
+    _Alignas(64) void *keys[]; // size + 1 slots, keys[0] unused
+} frozen_tree;
+
 tree *create_tree(int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *create_tree_with_arena(int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int nodes_per_block);
 tree *build_tree_from_array(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *build_tree_parallel(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int threads);
+void serial_merge(void **a, size_t na, void **b, size_t nb, void **out, int (*compare)(const void *, const void *));
+void serial_merge_sort(void **a, void **tmp, size_t n, int (*compare)(const void *, const void *));
+tree *build_tree_from_sorted(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+bool is_sorted_array(void **data, int size, int (*compare_func)(const void *, const void *));
+node *build_sorted_range(tree *tree_obj, void **data, int lo, int hi, bool *failed);
 void insert(tree *tree_obj, void *data);
 bool search(tree *tree_obj, const void *data);
 void delete_tree(tree *tree_obj, void *data);
@@ -38,15 +92,55 @@ void update_height(node *node_obj);
 int get_size_tree(const tree *tree_obj);
 node *insert_node(tree *tree_obj, node *current, void *data_obj);
 node *search_node(tree *tree_obj, node *current, const void *data_obj);
-node *delete_node_recursive(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
+void search_batch(tree *tree_obj, const void **keys, size_t n, void **out);
+node *find(const tree *tree_obj, const void *key);
+node *lower_bound(const tree *tree_obj, const void *key);
+node *upper_bound(const tree *tree_obj, const void *key);
+node *find_floor(const tree *tree_obj, const void *key);
+node *find_ceiling(const tree *tree_obj, const void *key);
+node *predecessor(const tree *tree_obj, const void *key);
+node *successor(const tree *tree_obj, const void *key);
+node *min_node(const tree *tree_obj);
+node *max_node(const tree *tree_obj);
+node *iter_begin(tree_iter *it, const tree *tree_obj);
+node *iter_last(tree_iter *it, const tree *tree_obj);
+node *iter_seek(tree_iter *it, const tree *tree_obj, const void *key);
+node *iter_next(tree_iter *it);
+node *iter_prev(tree_iter *it);
+#ifdef AVL_ORDER_STATS
+int get_count(const node *node_obj);
+node *select_kth(const tree *tree_obj, int k);
+int rank(const tree *tree_obj, const void *key);
+int count_range(const tree *tree_obj, const void *lo, const void *hi);
+#endif
+node *delete_node_iterative(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
 node *find_min(node *current);
 void display_tree_recursive(tree *tree_obj, node *parent, const char *prefix, bool is_left, int depth);
 void preorder_recursive(node *current, void **nodes, int *i);
 void inorder_recursive(node *current, void **nodes, int *i);
 void postorder_recursive(node *current, void **nodes, int *i);
 void free_nodes_recursive(node *current);
+node_arena *arena_create(int nodes_per_block);
+void arena_destroy(node_arena *arena);
+node *node_alloc(tree *tree_obj);
+void node_release(tree *tree_obj, node *node_obj);
+tree *avl_join(tree *left, void *data, tree *right);
+void *avl_split(tree *tree_obj, const void *key, tree **less, tree **greater);
+tree *avl_union(tree *a, tree *b);
+tree *avl_intersection(tree *a, tree *b);
+tree *avl_difference(tree *a, tree *b);
+node *join_nodes(node *l, node *k, node *r);
+node *join_right(node *l, node *k, node *r);
+node *join_left(node *l, node *k, node *r);
+node *join2_nodes(node *l, node *r);
+void split_nodes(int (*compare)(const void *, const void *), node *t, const void *key, node **l, node **r, node **found);
+frozen_tree *freeze(tree *tree_obj);
+void *frozen_search(const frozen_tree *frozen, const void *data);
+void *frozen_lower_bound(const frozen_tree *frozen, const void *data);
+void free_frozen(frozen_tree *frozen);
 int get_balance_factor(node *current);
 node *rotate_left(node *current);
 node *rotate_right(node *current);
+node *rebalance(node *current);
 
 #endif
\ No newline at end of file
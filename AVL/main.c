@@ -1,6 +1,9 @@
 #include "header.h"
+#include "typed_avl.h"
 #include <time.h>
 
+DEFINE_AVL(int_avl, int, AVL_CMP_NUM(a, b))
+
 int compare_int(const void *a, const void *b) {
     int int_a = *(int *)a;
     int int_b = *(int *)b;
@@ -26,7 +29,177 @@ void print_double(const void *data) {
     printf("%.2f", *(double *)data);
 }
 
-int main() {
+// Shuffled 0..n-1 inserted, then deleted in a second shuffle; 23Tree/main.c
+// runs the same workload so the two delete latencies can be compared.
+void shuffle_keys(int *keys, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+}
+
+void bench_delete(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i;
+    }
+    srand(42);
+    shuffle_keys(keys, num_elements);
+    tree *avl = create_tree(compare_int, print_int);
+    for (int i = 0; i < num_elements; i++) {
+        insert(avl, &keys[i]);
+    }
+    int *order = (int *)malloc(sizeof(int) * num_elements); // the tree points into keys[], so shuffle a copy
+    memcpy(order, keys, sizeof(int) * num_elements);
+    shuffle_keys(order, num_elements);
+    clock_t start = clock();
+    for (int i = 0; i < num_elements; i++) {
+        delete_tree(avl, &order[i]);
+    }
+    double delete_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    printf("AVL: %d deletes in %.2f ms (%.1f ns/delete), size after %d\n",
+           num_elements, delete_ms, delete_ms * 1e6 / num_elements, get_size_tree(avl));
+    free_tree(avl);
+    free(order);
+    free(keys);
+}
+
+// Cold start from a sorted snapshot: O(n) build against n inserts
+void bench_sorted_build(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements);
+    void **ptrs = (void **)malloc(sizeof(void *) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i;
+        ptrs[i] = &keys[i];
+    }
+    clock_t start = clock();
+    tree *built = build_tree_from_sorted(ptrs, num_elements, compare_int, print_int);
+    double build_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    tree *inserted = create_tree(compare_int, print_int);
+    for (int i = 0; i < num_elements; i++) {
+        insert(inserted, ptrs[i]);
+    }
+    double insert_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    printf("AVL: sorted build of %d in %.2f ms (height %d), insert loop %.2f ms (height %d)\n",
+           num_elements, build_ms, get_height(built->root), insert_ms, get_height(inserted->root));
+    free_tree(built);
+    free_tree(inserted);
+    free(ptrs);
+    free(keys);
+}
+
+// Random lookups of present keys: one search_node descent at a time against
+// search_batch, which overlaps the cache misses of SEARCH_BATCH_GROUP lookups
+void bench_search_batch(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements);
+    const void **probes = (const void **)malloc(sizeof(void *) * num_elements);
+    void **out = (void **)malloc(sizeof(void *) * num_elements);
+    srand(42);
+    tree *searched = create_tree(compare_int, print_int);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand();
+        insert(searched, &keys[i]);
+    }
+    for (int i = 0; i < num_elements; i++) {
+        probes[i] = &keys[rand() % num_elements];
+    }
+    clock_t start = clock();
+    int found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        found += search_node(searched, searched->root, probes[i]) != NULL;
+    }
+    double single_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    search_batch(searched, probes, num_elements, out);
+    double batch_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    int batch_found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        batch_found += out[i] != NULL;
+    }
+    printf("%s: %d lookups in a tree of %d, search_node %.2f ms (%d found), search_batch %.2f ms (%d found)\n",
+           "AVL", num_elements, get_size_tree(searched), single_ms, found, batch_ms, batch_found);
+    free_tree(searched);
+    free(out);
+    free(probes);
+    free(keys);
+}
+
+// Unsorted ingest: insert loop against the parallel sort-then-build path
+void bench_parallel_build(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements);
+    void **ptrs = (void **)malloc(sizeof(void *) * num_elements);
+    srand(42);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand();
+        ptrs[i] = &keys[i];
+    }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    tree *inserted = create_tree(compare_int, print_int);
+    for (int i = 0; i < num_elements; i++) {
+        insert(inserted, ptrs[i]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double insert_ms = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    free_tree(inserted);
+    printf("%s: insert loop of %d in %.2f ms\n", "AVL", num_elements, insert_ms);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int threads = 1; threads <= cpus; threads *= 2) { // wall clock, so clock() would sum the threads
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        tree *built = build_tree_parallel(ptrs, num_elements, compare_int, print_int, threads);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double build_ms = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1e6;
+        printf("%s: parallel build on %2d threads in %.2f ms (size %d, height %d)\n",
+               "AVL", threads, build_ms, get_size_tree(built), get_height(built->root));
+        free_tree(built);
+    }
+    free(ptrs);
+    free(keys);
+}
+
+// Two overlapping sets (multiples of 2 and of 3) combined by the join-based operations
+void bench_set_ops(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements * 3);
+    void **evens = (void **)malloc(sizeof(void *) * num_elements);
+    void **threes = (void **)malloc(sizeof(void *) * num_elements);
+    for (int i = 0; i < num_elements * 3; i++) {
+        keys[i] = i;
+    }
+    for (int i = 0; i < num_elements; i++) {
+        evens[i] = &keys[2 * i];
+        threes[i] = &keys[3 * i];
+    }
+    const char *names[] = {"union", "intersection", "difference"};
+    for (int op = 0; op < 3; op++) {
+        tree *a = build_tree_from_sorted(evens, num_elements, compare_int, print_int);
+        tree *b = build_tree_from_sorted(threes, num_elements, compare_int, print_int);
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        tree *result = op == 0 ? avl_union(a, b) : op == 1 ? avl_intersection(a, b) : avl_difference(a, b);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double op_ms = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1e6;
+        printf("AVL: %-12s of two %d-key sets in %.2f ms (size %d)\n", names[op], num_elements, op_ms, get_size_tree(result));
+        free_tree(result);
+    }
+    free(evens);
+    free(threes);
+    free(keys);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) { // ./gen_avl bench [elements]
+        int num_elements = argc > 2 ? atoi(argv[2]) : 1000000;
+        bench_search_batch(num_elements);
+        bench_delete(num_elements);
+        bench_sorted_build(num_elements);
+        bench_parallel_build(num_elements);
+        bench_set_ops(num_elements);
+        return 0;
+    }
     srand(time(NULL)); 
     printf("TESTING BINARY SEARCH TREE WITH INTEGERS\n\n");
 
@@ -65,6 +238,47 @@ int main() {
     search(int_tree, &not_in_tree);
     printf("\n");
 
+    void *batch_out[NUM_INTS];
+    search_batch(int_tree, (const void **)generic_ptr_int, NUM_INTS, batch_out);
+    int batch_found = 0;
+    for (int i = 0; i < NUM_INTS; i++) {
+        batch_found += batch_out[i] != NULL;
+    }
+    printf("Batch search found %d of %d generated values\n\n", batch_found, NUM_INTS);
+
+    int probe = 500;
+    node *lo = find_floor(int_tree, &probe);
+    node *hi = find_ceiling(int_tree, &probe);
+    node *below = predecessor(int_tree, &probe);
+    node *above = successor(int_tree, &probe);
+    printf("Around %d: floor %d, ceiling %d, predecessor %d, successor %d\n", probe,
+           lo ? *(int *)lo->data : -1, hi ? *(int *)hi->data : -1,
+           below ? *(int *)below->data : -1, above ? *(int *)above->data : -1);
+    printf("Min %d, max %d, find(%d) %s\n\n", *(int *)min_node(int_tree)->data, *(int *)max_node(int_tree)->data,
+           *int_data[3], find(int_tree, int_data[3]) ? "hit" : "miss");
+
+    tree_iter cursor;
+    printf("First 10 via cursor:");
+    int shown = 0;
+    for (node *it_node = iter_begin(&cursor, int_tree); it_node && shown < 10; it_node = iter_next(&cursor), shown++) {
+        printf(" %d", *(int *)it_node->data);
+    }
+    printf("\nValues in [%d, %d) via iter_seek:", probe, probe + 50);
+    int range_end = probe + 50;
+    for (node *it_node = iter_seek(&cursor, int_tree, &probe); it_node && compare_int(it_node->data, &range_end) < 0; it_node = iter_next(&cursor)) {
+        printf(" %d", *(int *)it_node->data);
+    }
+    printf("\n\n");
+
+#ifdef AVL_ORDER_STATS
+    int tree_size = get_size_tree(int_tree);
+    node *median = select_kth(int_tree, tree_size / 2);
+    node *p90 = select_kth(int_tree, tree_size * 9 / 10);
+    printf("Median %d, p90 %d, rank(%d) = %d, %d values in [%d, %d]\n\n",
+           *(int *)median->data, *(int *)p90->data, probe, rank(int_tree, &probe),
+           count_range(int_tree, &probe, &range_end), probe, range_end);
+#endif
+
     printf("Deleting node with value: %d\n", *int_data[2]);
     delete_tree(int_tree, int_data[2]);
     printf("Deleting node with value: %d\n", *int_data[5]);
@@ -97,6 +311,39 @@ int main() {
     printf("\n");
 
 
+    printf("\nTESTING ARENA-BACKED TREE WITH INTEGERS\n\n");
+
+    tree *arena_tree = create_tree_with_arena(compare_int, print_int, 64);
+    for (int i = 0; i < NUM_INTS; i++) {
+        insert(arena_tree, int_data[i]);
+    }
+    printf("Arena tree size after inserts: %d\n", get_size_tree(arena_tree));
+    delete_tree(arena_tree, int_data[7]);
+    insert(arena_tree, int_data[7]); // reuses the released slot
+    printf("Arena tree size after delete/reinsert: %d\n\n", get_size_tree(arena_tree));
+    free_tree(arena_tree);
+
+    printf("TESTING FROZEN SNAPSHOT OF THE INTEGER TREE\n\n");
+
+    frozen_tree *frozen = freeze(int_tree);
+    void *frozen_hit = frozen_search(frozen, int_data[3]);
+    printf("Frozen search for %d: %s\n", *int_data[3], frozen_hit ? "found" : "not found");
+    printf("Frozen search for %d: %s\n\n", not_in_tree, frozen_search(frozen, &not_in_tree) ? "found" : "not found");
+    free_frozen(frozen);
+
+    printf("TESTING TYPE-SPECIALIZED AVL WITH INTEGERS\n\n");
+
+    int_avl_tree *typed_tree = int_avl_create();
+    for (int i = 0; i < NUM_INTS; i++) {
+        int_avl_insert(typed_tree, *int_data[i], int_data[i]);
+    }
+    printf("Typed tree size: %d, height: %d\n", typed_tree->size, int_avl_height(typed_tree->root));
+    int_avl_node *typed_hit = int_avl_search(typed_tree, *int_data[3]);
+    printf("Typed search for %d: %s\n", *int_data[3], typed_hit ? "found" : "not found");
+    int_avl_delete(typed_tree, *int_data[3]);
+    printf("Typed search after delete: %s\n\n", int_avl_search(typed_tree, *int_data[3]) ? "found" : "not found");
+    int_avl_free(typed_tree);
+
     printf("Cleaning up memory\n");
     
     for (int i = 0; i < NUM_INTS; i++) {
@@ -1,7 +1,14 @@
 #include "header.h"
 
 tree *create_tree(int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *create_tree_with_arena(int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int nodes_per_block);
 tree *build_tree_from_array(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *build_tree_parallel(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int threads);
+void serial_merge(void **a, size_t na, void **b, size_t nb, void **out, int (*compare)(const void *, const void *));
+void serial_merge_sort(void **a, void **tmp, size_t n, int (*compare)(const void *, const void *));
+tree *build_tree_from_sorted(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+bool is_sorted_array(void **data, int size, int (*compare_func)(const void *, const void *));
+node *build_sorted_range(tree *tree_obj, void **data, int lo, int hi, bool *failed);
 void insert(tree *tree_obj, void *data); // TO MODIFY
 bool search(tree *tree_obj, const void *data);
 void delete_tree(tree *tree_obj, void *data); // TO MODIFY
@@ -16,16 +23,56 @@ void update_height(node *node_obj);
 int get_size_tree(const tree *tree_obj);
 node *insert_node(tree *tree_obj, node *current, void *data_obj);
 node *search_node(tree *tree_obj, node *current, const void *data_obj);
-node *delete_node_recursive(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
+void search_batch(tree *tree_obj, const void **keys, size_t n, void **out);
+node *find(const tree *tree_obj, const void *key);
+node *lower_bound(const tree *tree_obj, const void *key);
+node *upper_bound(const tree *tree_obj, const void *key);
+node *find_floor(const tree *tree_obj, const void *key);
+node *find_ceiling(const tree *tree_obj, const void *key);
+node *predecessor(const tree *tree_obj, const void *key);
+node *successor(const tree *tree_obj, const void *key);
+node *min_node(const tree *tree_obj);
+node *max_node(const tree *tree_obj);
+node *iter_begin(tree_iter *it, const tree *tree_obj);
+node *iter_last(tree_iter *it, const tree *tree_obj);
+node *iter_seek(tree_iter *it, const tree *tree_obj, const void *key);
+node *iter_next(tree_iter *it);
+node *iter_prev(tree_iter *it);
+#ifdef AVL_ORDER_STATS
+int get_count(const node *node_obj);
+node *select_kth(const tree *tree_obj, int k);
+int rank(const tree *tree_obj, const void *key);
+int count_range(const tree *tree_obj, const void *lo, const void *hi);
+#endif
+node *delete_node_iterative(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
 node *find_min(node *current);
 void display_tree_recursive(tree *tree_obj, node *parent, const char *prefix, bool is_left, int depth);
 void preorder_recursive(node *current, void **nodes, int *i);
 void inorder_recursive(node *current, void **nodes, int *i);
 void postorder_recursive(node *current, void **nodes, int *i);
 void free_nodes_recursive(node *current);
+node_arena *arena_create(int nodes_per_block);
+void arena_destroy(node_arena *arena);
+node *node_alloc(tree *tree_obj);
+void node_release(tree *tree_obj, node *node_obj);
+tree *avl_join(tree *left, void *data, tree *right);
+void *avl_split(tree *tree_obj, const void *key, tree **less, tree **greater);
+tree *avl_union(tree *a, tree *b);
+tree *avl_intersection(tree *a, tree *b);
+tree *avl_difference(tree *a, tree *b);
+node *join_nodes(node *l, node *k, node *r);
+node *join_right(node *l, node *k, node *r);
+node *join_left(node *l, node *k, node *r);
+node *join2_nodes(node *l, node *r);
+void split_nodes(int (*compare)(const void *, const void *), node *t, const void *key, node **l, node **r, node **found);
+frozen_tree *freeze(tree *tree_obj);
+void *frozen_search(const frozen_tree *frozen, const void *data);
+void *frozen_lower_bound(const frozen_tree *frozen, const void *data);
+void free_frozen(frozen_tree *frozen);
 int get_balance_factor(node *current);
 node *rotate_left(node *current);
 node *rotate_right(node *current);
+node *rebalance(node *current);
 
 int get_balance_factor(node *current) {
     int left = current->left ? get_height(current->left) : 0;
@@ -51,6 +98,24 @@ node *rotate_left(node *current) {
     return B;
 }
 
+// refresh current's height and restore the AVL invariant, returning the new subtree root
+node *rebalance(node *current) {
+    update_height(current);
+    int bf = get_balance_factor(current);
+    if(bf > 1) { // left heavy
+        if(get_balance_factor(current->left) < 0) {
+            current->left = rotate_left(current->left);
+        }
+        return rotate_right(current);
+    }else if(bf < -1) { // right heavy
+        if(get_balance_factor(current->right) > 0) {
+            current->right = rotate_right(current->right);
+        }
+        return rotate_left(current);
+    }
+    return current;
+}
+
 bool is_empty(const tree *tree_obj) {
     return tree_obj->size<=0;
 }
@@ -74,10 +139,85 @@ tree *create_tree(int (*compare_func)(const void *, const void *), void (*print_
     tree_obj->size = 0;
     tree_obj->compare = compare_func;
     tree_obj->print_func = print_func;
+    tree_obj->arena = NULL;
     return tree_obj;
 }
 
+tree *create_tree_with_arena(int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int nodes_per_block) {
+    tree *tree_obj = create_tree(compare_func, print_func);
+    if (!tree_obj) return NULL;
+    tree_obj->arena = arena_create(nodes_per_block);
+    if (!tree_obj->arena) {
+        free(tree_obj);
+        return NULL;
+    }
+    return tree_obj;
+}
+
+node_arena *arena_create(int nodes_per_block) {
+    node_arena *arena = (node_arena *)malloc(sizeof(node_arena));
+    if (!arena) {
+        perror("Failed to allocate memory for node arena");
+        return NULL;
+    }
+    arena->blocks = NULL;
+    arena->free_list = NULL;
+    arena->nodes_per_block = nodes_per_block > 0 ? nodes_per_block : 1024;
+    return arena;
+}
+
+void arena_destroy(node_arena *arena) {
+    if (!arena) return;
+    node_block *block = arena->blocks;
+    while (block) { // one free per block, nodes are never walked
+        node_block *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+node *node_alloc(tree *tree_obj) {
+    node_arena *arena = tree_obj->arena;
+    if (!arena) {
+        return (node *)malloc(sizeof(node));
+    }
+    if (arena->free_list) { // reuse a released slot first
+        node *reused = arena->free_list;
+        arena->free_list = reused->left;
+        return reused;
+    }
+    node_block *block = arena->blocks;
+    if (!block || block->used == arena->nodes_per_block) {
+        block = (node_block *)malloc(sizeof(node_block) + sizeof(node) * arena->nodes_per_block);
+        if (!block) {
+            perror("Failed to allocate node block");
+            return NULL;
+        }
+        block->used = 0;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+    return &block->nodes[block->used++];
+}
+
+void node_release(tree *tree_obj, node *node_obj) {
+    node_arena *arena = tree_obj->arena;
+    if (!arena) {
+        free(node_obj);
+        return;
+    }
+    node_obj->left = arena->free_list;
+    arena->free_list = node_obj;
+}
+
 tree *build_tree_from_array(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *)) {
+    if (is_sorted_array(data, size, compare_func)) { // one O(n) pass buys an O(n) build
+        return build_tree_from_sorted(data, size, compare_func, print_func);
+    }
+    if (size >= PARALLEL_BUILD_MIN) {
+        return build_tree_parallel(data, size, compare_func, print_func, 0);
+    }
     tree *tree_obj = create_tree(compare_func, print_func);
     if (!tree_obj) return NULL;
     
@@ -87,50 +227,340 @@ tree *build_tree_from_array(void **data, int size, int (*compare_func)(const voi
     return tree_obj;
 }
 
+// true when data is in non-decreasing order
+bool is_sorted_array(void **data, int size, int (*compare_func)(const void *, const void *)) {
+    for (int i = 1; i < size; i++) {
+        if (compare_func(data[i-1], data[i]) > 0) return false;
+    }
+    return true;
+}
+
+// Balanced subtree over data[lo..hi]: the middle element is the root, so the
+// two halves differ in size by at most one and no rotation is ever needed.
+// Nodes are taken in preorder, which keeps each root near its children.
+node *build_sorted_range(tree *tree_obj, void **data, int lo, int hi, bool *failed) {
+    if (lo > hi || *failed) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    node *node_obj = node_alloc(tree_obj);
+    if (!node_obj) {
+        *failed = true;
+        return NULL;
+    }
+    node_obj->data = data[mid];
+    node_obj->left = build_sorted_range(tree_obj, data, lo, mid - 1, failed);
+    node_obj->right = build_sorted_range(tree_obj, data, mid + 1, hi, failed);
+    update_height(node_obj);
+    tree_obj->size++;
+    return node_obj;
+}
+
+// O(n) construction from data sorted by compare_func. Duplicates are dropped
+// the way insert drops them, keeping the first of each run.
+tree *build_tree_from_sorted(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *)) {
+    tree *tree_obj = create_tree(compare_func, print_func);
+    if (!tree_obj) return NULL;
+    void **unique = data;
+    int count = size;
+    for (int i = 1; i < size; i++) {
+        if (compare_func(data[i-1], data[i]) == 0) { // compact a copy only when needed
+            unique = (void **)malloc(sizeof(void *) * size);
+            if (!unique) {
+                perror("Failed to allocate memory for sorted build");
+                free_tree(tree_obj);
+                return NULL;
+            }
+            count = 0;
+            for (int j = 0; j < size; j++) {
+                if (count == 0 || compare_func(unique[count-1], data[j]) != 0) {
+                    unique[count++] = data[j];
+                }
+            }
+            break;
+        }
+    }
+    bool failed = false;
+    tree_obj->root = build_sorted_range(tree_obj, unique, 0, count - 1, &failed);
+    if (unique != data) free(unique);
+    if (failed) {
+        perror("Failed to allocate memory for node");
+        free_tree(tree_obj);
+        return NULL;
+    }
+    return tree_obj;
+}
+
+// Parallel sort-then-build. Work is split fork-join style: a task with more
+// than one thread to spend hands half its range (and half its threads) to a
+// new pthread, does the other half itself and joins. If pthread_create fails
+// the half just runs inline.
+
+// stable: on ties the element from a wins
+void serial_merge(void **a, size_t na, void **b, size_t nb, void **out, int (*compare)(const void *, const void *)) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        out[k++] = compare(a[i], b[j]) <= 0 ? a[i++] : b[j++];
+    }
+    while (i < na) out[k++] = a[i++];
+    while (j < nb) out[k++] = b[j++];
+}
+
+// sorts a in place, tmp is scratch of the same length
+void serial_merge_sort(void **a, void **tmp, size_t n, int (*compare)(const void *, const void *)) {
+    if (n <= 16) { // insertion sort, stable
+        for (size_t i = 1; i < n; i++) {
+            void *item = a[i];
+            size_t j = i;
+            while (j > 0 && compare(a[j-1], item) > 0) {
+                a[j] = a[j-1];
+                j--;
+            }
+            a[j] = item;
+        }
+        return;
+    }
+    size_t half = n / 2;
+    serial_merge_sort(a, tmp, half, compare);
+    serial_merge_sort(a + half, tmp + half, n - half, compare);
+    serial_merge(a, half, a + half, n - half, tmp, compare);
+    memcpy(a, tmp, sizeof(void *) * n);
+}
+
+typedef struct merge_task_struct {
+    void **a, **b, **out;
+    size_t na, nb;
+    int (*compare)(const void *, const void *);
+    int threads;
+} merge_task;
+
+// first index in a[0..n) whose element is > key (upper) or >= key (!upper)
+static size_t merge_bound(void **a, size_t n, const void *key, bool upper, int (*compare)(const void *, const void *)) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = compare(a[mid], key);
+        if (c < 0 || (upper && c == 0)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void *merge_task_run(void *arg);
+
+// Splits the longer run at its middle and the other run at the matching
+// bound, so both halves merge independently and ties still favour a.
+void parallel_merge(merge_task *task) {
+    size_t na = task->na, nb = task->nb;
+    if (task->threads <= 1 || na + nb < PARALLEL_SORT_CUTOFF) {
+        serial_merge(task->a, na, task->b, nb, task->out, task->compare);
+        return;
+    }
+    size_t ma, mb;
+    if (na >= nb) {
+        ma = na / 2;
+        mb = merge_bound(task->b, nb, task->a[ma], false, task->compare);
+    } else {
+        mb = nb / 2;
+        ma = merge_bound(task->a, na, task->b[mb], true, task->compare);
+    }
+    merge_task left = {task->a, task->b, task->out, ma, mb, task->compare, task->threads / 2};
+    merge_task right = {task->a + ma, task->b + mb, task->out + ma + mb, na - ma, nb - mb, task->compare, task->threads - task->threads / 2};
+    pthread_t worker;
+    bool forked = pthread_create(&worker, NULL, merge_task_run, &left) == 0;
+    if (!forked) parallel_merge(&left);
+    parallel_merge(&right);
+    if (forked) pthread_join(worker, NULL);
+}
+
+static void *merge_task_run(void *arg) {
+    parallel_merge((merge_task *)arg);
+    return NULL;
+}
+
+typedef struct sort_task_struct {
+    void **a, **tmp;
+    size_t n;
+    bool into_tmp; // result lands in tmp instead of a
+    int (*compare)(const void *, const void *);
+    int threads;
+} sort_task;
+
+static void *sort_task_run(void *arg);
+
+// The halves are sorted into the opposite buffer and merged back into the
+// target, so no level pays for a serial copy.
+void parallel_merge_sort(sort_task *task) {
+    if (task->threads <= 1 || task->n < PARALLEL_SORT_CUTOFF) {
+        serial_merge_sort(task->a, task->tmp, task->n, task->compare);
+        if (task->into_tmp) memcpy(task->tmp, task->a, sizeof(void *) * task->n);
+        return;
+    }
+    size_t half = task->n / 2;
+    sort_task left = {task->a, task->tmp, half, !task->into_tmp, task->compare, task->threads / 2};
+    sort_task right = {task->a + half, task->tmp + half, task->n - half, !task->into_tmp, task->compare, task->threads - task->threads / 2};
+    pthread_t worker;
+    bool forked = pthread_create(&worker, NULL, sort_task_run, &left) == 0;
+    if (!forked) parallel_merge_sort(&left);
+    parallel_merge_sort(&right);
+    if (forked) pthread_join(worker, NULL);
+    void **src = task->into_tmp ? task->a : task->tmp;
+    void **dst = task->into_tmp ? task->tmp : task->a;
+    merge_task merge = {src, src + half, dst, half, task->n - half, task->compare, task->threads};
+    parallel_merge(&merge);
+}
+
+static void *sort_task_run(void *arg) {
+    parallel_merge_sort((sort_task *)arg);
+    return NULL;
+}
+
+typedef struct build_task_struct {
+    void **data;
+    int lo, hi;
+    int threads;
+    bool failed;
+    node *root;
+} build_task;
+
+static void *build_task_run(void *arg);
+
+// balanced subtree over sorted, distinct data[lo..hi]; each task keeps its own
+// failure flag so forked halves never write shared state
+void build_parallel_range(build_task *task) {
+    if (task->lo > task->hi) {
+        task->root = NULL;
+        return;
+    }
+    int mid = task->lo + (task->hi - task->lo) / 2;
+    node *node_obj = (node *)malloc(sizeof(node));
+    if (!node_obj) {
+        task->failed = true;
+        task->root = NULL;
+        return;
+    }
+    node_obj->data = task->data[mid];
+    build_task left = {task->data, task->lo, mid - 1, task->threads / 2, false, NULL};
+    build_task right = {task->data, mid + 1, task->hi, task->threads - task->threads / 2, false, NULL};
+    pthread_t worker;
+    bool forked = false;
+    if (task->threads > 1 && task->hi - task->lo >= PARALLEL_SORT_CUTOFF) {
+        forked = pthread_create(&worker, NULL, build_task_run, &left) == 0;
+    }
+    if (!forked) {
+        left.threads = right.threads = 1;
+        build_parallel_range(&left);
+    }
+    build_parallel_range(&right);
+    if (forked) pthread_join(worker, NULL);
+    node_obj->left = left.root;
+    node_obj->right = right.root;
+    update_height(node_obj);
+    task->failed = left.failed || right.failed;
+    task->root = node_obj;
+}
+
+static void *build_task_run(void *arg) {
+    build_parallel_range((build_task *)arg);
+    return NULL;
+}
+
+// Sorts a copy of data on up to `threads` threads (<= 0: one per online CPU),
+// drops duplicates keeping the first of each run like insert does, and builds
+// a perfectly balanced tree with subtrees on separate threads.
+tree *build_tree_parallel(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int threads) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    tree *tree_obj = create_tree(compare_func, print_func);
+    if (!tree_obj || size <= 0) return tree_obj;
+    void **sorted = (void **)malloc(sizeof(void *) * size);
+    void **tmp = (void **)malloc(sizeof(void *) * size);
+    if (!sorted || !tmp) {
+        perror("Failed to allocate memory for parallel build");
+        free(sorted);
+        free(tmp);
+        free_tree(tree_obj);
+        return NULL;
+    }
+    memcpy(sorted, data, sizeof(void *) * size);
+    sort_task sort = {sorted, tmp, (size_t)size, false, compare_func, threads};
+    parallel_merge_sort(&sort);
+    free(tmp);
+
+    int count = 1;
+    for (int i = 1; i < size; i++) {
+        if (compare_func(sorted[count-1], sorted[i]) != 0) {
+            sorted[count++] = sorted[i];
+        }
+    }
+    build_task build = {sorted, 0, count - 1, threads, false, NULL};
+    build_parallel_range(&build);
+    free(sorted);
+    tree_obj->root = build.root;
+    if (build.failed) {
+        perror("Failed to allocate memory for node");
+        free_tree(tree_obj);
+        return NULL;
+    }
+    tree_obj->size = count;
+    return tree_obj;
+}
+
 void insert(tree *tree_obj , void *data) {
     tree_obj->root = insert_node(tree_obj, tree_obj->root, data);
 }
 
 void update_height(node *node_obj) {
     if (node_obj) {
-        node_obj->height = 1 + fmax(get_height(node_obj->left), get_height(node_obj->right));
+        int left = get_height(node_obj->left);
+        int right = get_height(node_obj->right);
+        node_obj->height = 1 + (left > right ? left : right);
+#ifdef AVL_ORDER_STATS
+        node_obj->count = 1 + get_count(node_obj->left) + get_count(node_obj->right);
+#endif
     }
 }
 
 node *insert_node(tree *tree_obj, node *current, void *data_obj) {
-    if (!current) {
-        node *new_node = (node *)malloc(sizeof(node));
-        new_node->data = data_obj;
-        new_node->left = NULL;
-        new_node->right = NULL;
-        new_node->height = 1; // Leaf node has height 1
-        tree_obj->size++;
-        return new_node;
-    } if (tree_obj->compare(data_obj, current->data) < 0) {
-        current->left = insert_node(tree_obj, current->left, data_obj);
-    } else if (tree_obj->compare(data_obj, current->data) > 0) {
-        current->right = insert_node(tree_obj, current->right, data_obj);
-    } 
-    update_height(current);
+    node **path[AVL_MAX_HEIGHT]; // links from the subtree root down to the insertion point
+    node *root = current;
+    node **link = &root;
+    int depth = 0;
+    while (*link) {
+        int comparison = tree_obj->compare(data_obj, (*link)->data);
+        if (comparison == 0) return root; // already present
+        path[depth++] = link;
+        link = comparison < 0 ? &(*link)->left : &(*link)->right;
+    }
+    node *new_node = node_alloc(tree_obj);
+    if (!new_node) return root;
+    new_node->data = data_obj;
+    new_node->left = NULL;
+    new_node->right = NULL;
+    new_node->height = 1; // Leaf node has height 1
+#ifdef AVL_ORDER_STATS
+    new_node->count = 1;
+#endif
+    *link = new_node;
+    tree_obj->size++;
 
-    int bf = get_balance_factor(current);
-    if(bf > 1) { // left heavy
-        if(get_balance_factor(current->left) >= 0) {
-            return rotate_right(current);
-        }else{
-            current->left = rotate_left(current->left);
-            return rotate_right(current);
-        }
-    }else if(bf < -1) { // right heavy
-        if(get_balance_factor(current->right) <= 0) {
-            return rotate_left(current);
-        }else{
-            current->right = rotate_right(current->right);
-            return rotate_left(current);
+    // retrace: once a subtree keeps its old height nothing above it can change
+    for (int i = depth - 1; i >= 0; i--) {
+        node *ancestor = *path[i];
+        int old_height = ancestor->height;
+        node *balanced = rebalance(ancestor);
+        *path[i] = balanced;
+        if (balanced->height == old_height) {
+#ifdef AVL_ORDER_STATS
+            while (--i >= 0) (*path[i])->count++; // heights hold above, sizes still grow
+#endif
+            break;
         }
     }
-
-    return current;
+    return root;
 }
 
 bool search(tree *tree_obj, const void *data) {
@@ -150,18 +580,50 @@ bool search(tree *tree_obj, const void *data) {
 }
 
 node *search_node(tree *tree_obj, node *current, const void *data_obj) {
-    if (current == NULL) {
-        return NULL; // Data not found
+    while (current) {
+        int comparison = tree_obj->compare(data_obj, current->data);
+        if (comparison == 0) return current;
+        current = comparison < 0 ? current->left : current->right;
     }
-    
-    int comparison = tree_obj->compare(data_obj, current->data);
-    
-    if (comparison == 0) {
-        return current;
-    } else if (comparison < 0) {
-        return search_node(tree_obj, current->left, data_obj);
-    } else {
-        return search_node(tree_obj, current->right, data_obj);
+    return NULL; // Data not found
+}
+
+// Group prefetching: SEARCH_BATCH_GROUP lookups descend one level per round.
+// Each round first touches every cursor's data (its node was prefetched a
+// round earlier), then compares and prefetches the next child, so the cache
+// misses of the whole group overlap instead of serialising.
+void search_batch(tree *tree_obj, const void **keys, size_t n, void **out) {
+    node *cursor[SEARCH_BATCH_GROUP];
+    for (size_t base = 0; base < n; base += SEARCH_BATCH_GROUP) {
+        int group = n - base < SEARCH_BATCH_GROUP ? (int)(n - base) : SEARCH_BATCH_GROUP;
+        int active = tree_obj->root ? group : 0;
+        for (int i = 0; i < group; i++) {
+            cursor[i] = tree_obj->root;
+            out[base + i] = NULL;
+        }
+        while (active > 0) {
+            for (int i = 0; i < group; i++) {
+                if (cursor[i]) __builtin_prefetch(cursor[i]->data);
+            }
+            for (int i = 0; i < group; i++) {
+                node *current = cursor[i];
+                if (!current) continue;
+                int comparison = tree_obj->compare(keys[base + i], current->data);
+                if (comparison == 0) {
+                    out[base + i] = current->data;
+                    cursor[i] = NULL;
+                    active--;
+                    continue;
+                }
+                node *next = comparison < 0 ? current->left : current->right;
+                cursor[i] = next;
+                if (next) {
+                    __builtin_prefetch(next);
+                } else {
+                    active--;
+                }
+            }
+        }
     }
 }
 
@@ -177,65 +639,285 @@ node *find_min(node *current) {
     return current;
 }
 
-void delete_tree(tree *tree_obj , void *data) {
-    bool deleted = false;
-    tree_obj->root = delete_node_recursive(tree_obj, tree_obj->root, data, &deleted);
+// Silent query family. Each is one root-to-leaf pass with a single compare
+// per level; the bounds remember the last node on the qualifying side.
+node *find(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root;
+    while (current) {
+        int comparison = tree_obj->compare(key, current->data);
+        if (comparison == 0) return current;
+        current = comparison < 0 ? current->left : current->right;
+    }
+    return NULL;
 }
 
-node *delete_node_recursive(tree *tree_obj, node *current, const void *data_obj, bool *deleted) {
-    if (current == NULL) {
-        return NULL;
+// Smallest node >= key
+node *lower_bound(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) <= 0) {
+            best = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
     }
-    int comparison = tree_obj->compare(data_obj, current->data);
-    if (comparison < 0) {
-        current->left = delete_node_recursive(tree_obj, current->left, data_obj, deleted);
-    } else if (comparison > 0) {
-        current->right = delete_node_recursive(tree_obj, current->right, data_obj, deleted);
-    } else {
-        *deleted = true;
-        tree_obj->size--;
-        if (current->left == NULL && current->right == NULL) {
-            free(current);
-            return NULL;
+    return best;
+}
+
+// Smallest node > key
+node *upper_bound(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) < 0) {
+            best = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return best;
+}
+
+// Largest node <= key
+node *find_floor(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) >= 0) {
+            best = current;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return best;
+}
+
+node *find_ceiling(const tree *tree_obj, const void *key) {
+    return lower_bound(tree_obj, key);
+}
+
+// Largest node < key (key need not be in the tree)
+node *predecessor(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) > 0) {
+            best = current;
+            current = current->right;
+        } else {
+            current = current->left;
         }
-        //1 child
-        if (current->left == NULL) {
-            node *temp = current->right;
-            free(current);
-            return temp;
-        } else if (current->right == NULL) {
-            node *temp = current->left;
-            free(current);
-            return temp;
+    }
+    return best;
+}
+
+// Smallest node > key (key need not be in the tree)
+node *successor(const tree *tree_obj, const void *key) {
+    return upper_bound(tree_obj, key);
+}
+
+node *min_node(const tree *tree_obj) {
+    return tree_obj->root ? find_min(tree_obj->root) : NULL;
+}
+
+node *max_node(const tree *tree_obj) {
+    node *current = tree_obj->root;
+    if (!current) return NULL;
+    while (current->right) current = current->right;
+    return current;
+}
+
+static void iter_push(tree_iter *it, node *node_obj) {
+    if (it->depth == ITER_MAX_DEPTH) {
+        it->overflow = true;
+        return;
+    }
+    it->path[it->depth++] = node_obj;
+}
+
+static void iter_reset(tree_iter *it, const tree *tree_obj) {
+    it->tree_obj = tree_obj;
+    it->current = NULL;
+    it->depth = 0;
+    it->overflow = false;
+}
+
+// Positions the cursor on the smallest node and returns it
+node *iter_begin(tree_iter *it, const tree *tree_obj) {
+    iter_reset(it, tree_obj);
+    for (node *current = tree_obj->root; current; current = current->left) {
+        iter_push(it, current);
+        it->current = current;
+    }
+    return it->current;
+}
+
+// Positions the cursor on the largest node, for reverse scans
+node *iter_last(tree_iter *it, const tree *tree_obj) {
+    iter_reset(it, tree_obj);
+    for (node *current = tree_obj->root; current; current = current->right) {
+        iter_push(it, current);
+        it->current = current;
+    }
+    return it->current;
+}
+
+// Positions the cursor on the first node >= key
+node *iter_seek(tree_iter *it, const tree *tree_obj, const void *key) {
+    iter_reset(it, tree_obj);
+    int best_depth = 0;
+    node *current = tree_obj->root;
+    while (current) {
+        iter_push(it, current);
+        if (tree_obj->compare(key, current->data) <= 0) {
+            it->current = current;
+            best_depth = it->depth;
+            current = current->left;
+        } else {
+            current = current->right;
         }
+    }
+    it->depth = best_depth; // drop the part of the path below the answer
+    return it->current;
+}
 
-        // two children.
-        node *temp = find_min(current->right);
-        current->data = temp->data;
-        current->right = delete_node_recursive(tree_obj, current->right, temp->data, deleted);
+node *iter_next(tree_iter *it) {
+    node *current = it->current;
+    if (!current) return NULL;
+    if (it->overflow) return it->current = successor(it->tree_obj, current->data);
+    if (current->right) {
+        for (node *child = current->right; child; child = child->left) {
+            iter_push(it, child);
+            current = child;
+        }
+        return it->current = current;
     }
-    if (!current) { // base_case
-        return NULL; 
+    while (--it->depth > 0) { // climb until we leave a left subtree
+        node *parent = it->path[it->depth - 1];
+        if (parent->left == it->path[it->depth]) return it->current = parent;
     }
+    return it->current = NULL;
+}
 
-    update_height(current);
-    int bf = get_balance_factor(current);
-    if(bf > -1) { // left heavy
-        if(get_balance_factor(current->left) >= 0) {
-            return rotate_right(current);
-        }else{
-            current->left = rotate_left(current->left);
-            return rotate_right(current);
+node *iter_prev(tree_iter *it) {
+    node *current = it->current;
+    if (!current) return NULL;
+    if (it->overflow) return it->current = predecessor(it->tree_obj, current->data);
+    if (current->left) {
+        for (node *child = current->left; child; child = child->right) {
+            iter_push(it, child);
+            current = child;
         }
-    }else if(bf < 1) { // right heavy
-        if(get_balance_factor(current->right) <= 0) {
-            return rotate_left(current);
-        }else{
-            current->right = rotate_right(current->right);
-            return rotate_left(current);
+        return it->current = current;
+    }
+    while (--it->depth > 0) { // climb until we leave a right subtree
+        node *parent = it->path[it->depth - 1];
+        if (parent->right == it->path[it->depth]) return it->current = parent;
+    }
+    return it->current = NULL;
+}
+
+#ifdef AVL_ORDER_STATS
+int get_count(const node *node_obj) {
+    return node_obj ? node_obj->count : 0;
+}
+
+// k-th smallest node, 0-based; NULL when k is out of range
+node *select_kth(const tree *tree_obj, int k) {
+    node *current = tree_obj->root;
+    while (current) {
+        int left = get_count(current->left);
+        if (k < left) {
+            current = current->left;
+        } else if (k == left) {
+            return current;
+        } else {
+            k -= left + 1;
+            current = current->right;
         }
     }
-    return current;
+    return NULL;
+}
+
+// number of nodes < key (inclusive: <= key)
+static int count_below(const tree *tree_obj, const void *key, bool inclusive) {
+    int below = 0;
+    node *current = tree_obj->root;
+    while (current) {
+        int comparison = tree_obj->compare(key, current->data);
+        if (comparison < 0 || (comparison == 0 && !inclusive)) {
+            current = current->left;
+        } else {
+            below += get_count(current->left) + 1;
+            current = current->right;
+        }
+    }
+    return below;
+}
+
+// number of nodes strictly below key, i.e. the index key has or would take
+int rank(const tree *tree_obj, const void *key) {
+    return count_below(tree_obj, key, false);
+}
+
+// number of nodes in [lo, hi]
+int count_range(const tree *tree_obj, const void *lo, const void *hi) {
+    if (tree_obj->compare(lo, hi) > 0) return 0;
+    return count_below(tree_obj, hi, true) - count_below(tree_obj, lo, false);
+}
+#endif
+
+void delete_tree(tree *tree_obj , void *data) {
+    bool deleted = false;
+    tree_obj->root = delete_node_iterative(tree_obj, tree_obj->root, data, &deleted);
+}
+
+node *delete_node_iterative(tree *tree_obj, node *current, const void *data_obj, bool *deleted) {
+    node **path[AVL_MAX_HEIGHT];
+    node *root = current;
+    node **link = &root;
+    int depth = 0;
+    while (*link) {
+        int comparison = tree_obj->compare(data_obj, (*link)->data);
+        if (comparison == 0) break;
+        path[depth++] = link;
+        link = comparison < 0 ? &(*link)->left : &(*link)->right;
+    }
+    node *target = *link;
+    if (!target) return root;
+    *deleted = true;
+    tree_obj->size--;
+
+    if (target->left && target->right) { // two children: unlink the successor instead
+        path[depth++] = link;
+        node **succ_link = &target->right;
+        while ((*succ_link)->left) {
+            path[depth++] = succ_link;
+            succ_link = &(*succ_link)->left;
+        }
+        node *succ = *succ_link;
+        target->data = succ->data;
+        *succ_link = succ->right;
+        node_release(tree_obj, succ);
+    } else {
+        *link = target->left ? target->left : target->right;
+        node_release(tree_obj, target);
+    }
+
+    // a rotation during delete may still shrink the subtree, so keep going until a height holds
+    for (int i = depth - 1; i >= 0; i--) {
+        node *ancestor = *path[i];
+        int old_height = ancestor->height;
+        node *balanced = rebalance(ancestor);
+        *path[i] = balanced;
+        if (balanced->height == old_height) {
+#ifdef AVL_ORDER_STATS
+            while (--i >= 0) (*path[i])->count--;
+#endif
+            break;
+        }
+    }
+    return root;
 }
 
 void display(tree *tree_obj) {
@@ -321,9 +1003,269 @@ void postorder_recursive(node *current, void **nodes, int *i) {
     (*i)++;
 }
 
+// Join-based set operations (Blelloch, Ferizovic, Sun). Everything rests on
+// join(l, k, r) for l < k < r: walk down the spine of the taller tree to a
+// subtree no more than one level taller than the other, hang both under k and
+// rebalance back up. The set operations split one tree by the other's root,
+// recurse on the two halves (on a forked thread when there are threads to
+// spare and the subtrees are tall enough) and join the results, for
+// O(m log(n/m + 1)) work. They consume their inputs; dropped nodes are freed.
+
+node *join_right(node *l, node *k, node *r) {
+    if (get_height(l) <= get_height(r) + 1) {
+        k->left = l;
+        k->right = r;
+        update_height(k);
+        return k;
+    }
+    l->right = join_right(l->right, k, r);
+    return rebalance(l);
+}
+
+node *join_left(node *l, node *k, node *r) {
+    if (get_height(r) <= get_height(l) + 1) {
+        k->left = l;
+        k->right = r;
+        update_height(k);
+        return k;
+    }
+    r->left = join_left(l, k, r->left);
+    return rebalance(r);
+}
+
+node *join_nodes(node *l, node *k, node *r) {
+    if (get_height(l) > get_height(r) + 1) return join_right(l, k, r);
+    if (get_height(r) > get_height(l) + 1) return join_left(l, k, r);
+    k->left = l;
+    k->right = r;
+    update_height(k);
+    return k;
+}
+
+// detach the smallest node of t into *min_out, returning what is left
+static node *split_min(node *t, node **min_out) {
+    if (!t->left) {
+        *min_out = t;
+        return t->right;
+    }
+    t->left = split_min(t->left, min_out);
+    return rebalance(t);
+}
+
+// join without a middle key: every key of l is below every key of r
+node *join2_nodes(node *l, node *r) {
+    if (!l) return r;
+    if (!r) return l;
+    node *k;
+    r = split_min(r, &k);
+    return join_nodes(l, k, r);
+}
+
+// splits t around key into *l (< key) and *r (> key); a node equal to key is
+// detached into *found, otherwise *found is NULL
+void split_nodes(int (*compare)(const void *, const void *), node *t, const void *key, node **l, node **r, node **found) {
+    if (!t) {
+        *l = *r = *found = NULL;
+        return;
+    }
+    int comparison = compare(key, t->data);
+    if (comparison == 0) {
+        *l = t->left;
+        *r = t->right;
+        *found = t;
+        return;
+    }
+    if (comparison < 0) {
+        node *rest;
+        split_nodes(compare, t->left, key, l, &rest, found);
+        *r = join_nodes(rest, t, t->right);
+    } else {
+        node *rest;
+        split_nodes(compare, t->right, key, &rest, r, found);
+        *l = join_nodes(t->left, t, rest);
+    }
+}
+
+static int free_counted(node *t) {
+    if (!t) return 0;
+    int freed = 1 + free_counted(t->left) + free_counted(t->right);
+    free(t);
+    return freed;
+}
+
+typedef enum { SET_UNION, SET_INTERSECTION, SET_DIFFERENCE } set_op;
+
+typedef struct set_task_struct {
+    set_op op;
+    int (*compare)(const void *, const void *);
+    node *a, *b;
+    int threads;
+    int freed; // nodes dropped by this task, so sizes come out without a count pass
+    node *result;
+} set_task;
+
+static void *set_task_run(void *arg);
+
+static void set_operation(set_task *task) {
+    node *a = task->a, *b = task->b;
+    task->freed = 0;
+    if (!a || !b) {
+        if (task->op == SET_UNION) {
+            task->result = a ? a : b;
+        } else if (task->op == SET_INTERSECTION) {
+            task->freed = free_counted(a) + free_counted(b);
+            task->result = NULL;
+        } else {
+            task->freed = free_counted(b);
+            task->result = a;
+        }
+        return;
+    }
+    node *pivot, *l, *r, *dup;
+    if (task->op == SET_DIFFERENCE) { // walk b, carve a
+        pivot = b;
+        split_nodes(task->compare, a, pivot->data, &l, &r, &dup);
+    } else { // walk a, carve b
+        pivot = a;
+        split_nodes(task->compare, b, pivot->data, &l, &r, &dup);
+    }
+    set_task left = {task->op, task->compare, NULL, NULL, task->threads / 2, 0, NULL};
+    set_task right = {task->op, task->compare, NULL, NULL, task->threads - task->threads / 2, 0, NULL};
+    if (task->op == SET_DIFFERENCE) {
+        left.a = l;
+        left.b = pivot->left;
+        right.a = r;
+        right.b = pivot->right;
+    } else {
+        left.a = pivot->left;
+        left.b = l;
+        right.a = pivot->right;
+        right.b = r;
+    }
+    pthread_t worker;
+    bool forked = false;
+    if (task->threads > 1 && get_height(pivot) >= SET_OP_FORK_HEIGHT) {
+        forked = pthread_create(&worker, NULL, set_task_run, &left) == 0;
+    }
+    if (!forked) {
+        left.threads = right.threads = 1;
+        set_operation(&left);
+    }
+    set_operation(&right);
+    if (forked) pthread_join(worker, NULL);
+    task->freed = left.freed + right.freed;
+
+    bool keep_pivot = task->op == SET_UNION || (task->op == SET_INTERSECTION && dup);
+    if (dup) { // the pivot's twin from the other tree
+        free(dup);
+        task->freed++;
+    }
+    if (keep_pivot) {
+        task->result = join_nodes(left.result, pivot, right.result);
+    } else {
+        free(pivot);
+        task->freed++;
+        task->result = join2_nodes(left.result, right.result);
+    }
+}
+
+static void *set_task_run(void *arg) {
+    set_operation((set_task *)arg);
+    return NULL;
+}
+
+// arena nodes are not individually freeable and would end up shared between trees
+static bool set_op_supported(const tree *a, const tree *b) {
+    if ((a && a->arena) || (b && b->arena)) {
+        printf("Warning: join-based set operations do not support arena-backed trees.\n");
+        return false;
+    }
+    return true;
+}
+
+static int count_nodes(const node *t) {
+#ifdef AVL_ORDER_STATS
+    return get_count(t);
+#else
+    return t ? 1 + count_nodes(t->left) + count_nodes(t->right) : 0; // O(n) without counts
+#endif
+}
+
+static tree *run_set_operation(set_op op, tree *a, tree *b) {
+    if (!set_op_supported(a, b)) return NULL;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    set_task task = {op, a->compare, a->root, b->root, cpus > 0 ? (int)cpus : 1, 0, NULL};
+    set_operation(&task);
+    a->root = task.result;
+    a->size = a->size + b->size - task.freed;
+    free(b);
+    return a;
+}
+
+// All of a and b; on a shared key a's node is kept. Consumes both, returns a.
+tree *avl_union(tree *a, tree *b) {
+    return run_set_operation(SET_UNION, a, b);
+}
+
+// Keys present in both, as a's nodes. Consumes both, returns a.
+tree *avl_intersection(tree *a, tree *b) {
+    return run_set_operation(SET_INTERSECTION, a, b);
+}
+
+// Keys of a not present in b. Consumes both, returns a.
+tree *avl_difference(tree *a, tree *b) {
+    return run_set_operation(SET_DIFFERENCE, a, b);
+}
+
+// Concatenates right onto left, whose keys must all be smaller, with data (if
+// not NULL) between them. Consumes both trees and returns left.
+tree *avl_join(tree *left, void *data, tree *right) {
+    if (!set_op_supported(left, right)) return NULL;
+    if (data) {
+        node *k = node_alloc(left);
+        if (!k) {
+            perror("Failed to allocate memory for node");
+            return NULL;
+        }
+        k->data = data;
+        left->root = join_nodes(left->root, k, right->root);
+        left->size++;
+    } else {
+        left->root = join2_nodes(left->root, right->root);
+    }
+    left->size += right->size;
+    free(right);
+    return left;
+}
+
+// Splits tree_obj around key: *less gets the keys below it (reusing tree_obj)
+// and *greater, a new tree, the keys above. Returns the data stored under key,
+// or NULL; that node is freed. Without AVL_ORDER_STATS the new sizes cost a count.
+void *avl_split(tree *tree_obj, const void *key, tree **less, tree **greater) {
+    *less = *greater = NULL;
+    if (!set_op_supported(tree_obj, NULL)) return NULL;
+    tree *upper = create_tree(tree_obj->compare, tree_obj->print_func);
+    if (!upper) return NULL;
+    node *l, *r, *found;
+    split_nodes(tree_obj->compare, tree_obj->root, key, &l, &r, &found);
+    void *data = found ? found->data : NULL;
+    free(found);
+    tree_obj->root = l;
+    upper->root = r;
+    upper->size = count_nodes(r);
+    tree_obj->size = tree_obj->size - upper->size - (data != NULL);
+    *less = tree_obj;
+    *greater = upper;
+    return data;
+}
+
 void free_tree(tree *tree_obj) {
     if(tree_obj) {
-        free_nodes_recursive(tree_obj->root);
+        if (tree_obj->arena) {
+            arena_destroy(tree_obj->arena); // O(blocks)
+        } else {
+            free_nodes_recursive(tree_obj->root);
+        }
         free(tree_obj);
     }
 }
@@ -333,4 +1275,71 @@ void free_nodes_recursive(node *current) {
     free_nodes_recursive(current->left);
     free_nodes_recursive(current->right);
     free(current);
-} 
\ No newline at end of file
+} 
+
+frozen_tree *freeze(tree *tree_obj) {
+    int n = tree_obj->size;
+    size_t bytes = sizeof(frozen_tree) + sizeof(void *) * (n + 1);
+    frozen_tree *frozen = (frozen_tree *)aligned_alloc(64, (bytes + 63) & ~(size_t)63);
+    if (!frozen) {
+        perror("Failed to allocate memory for frozen tree");
+        return NULL;
+    }
+    frozen->size = n;
+    frozen->compare = tree_obj->compare;
+    frozen->keys[0] = NULL;
+    if (n == 0) return frozen;
+
+    // walk the AVL in order while walking the implicit Eytzinger tree in order
+    node *stack[AVL_MAX_HEIGHT];
+    int top = 0;
+    node *current = tree_obj->root;
+    int k = 1;
+    while (2 * k <= n) k *= 2; // leftmost Eytzinger slot
+    while (current || top > 0) {
+        while (current) {
+            stack[top++] = current;
+            current = current->left;
+        }
+        current = stack[--top];
+        frozen->keys[k] = current->data;
+        current = current->right;
+        if (2 * k + 1 <= n) { // Eytzinger successor: leftmost of the right subtree...
+            k = 2 * k + 1;
+            while (2 * k <= n) k *= 2;
+        } else { // ...or the first ancestor we reach from its left side
+            while (k & 1) k >>= 1;
+            k >>= 1;
+        }
+    }
+    return frozen;
+}
+
+void *frozen_lower_bound(const frozen_tree *frozen, const void *data) {
+    void *const *keys = frozen->keys;
+    int n = frozen->size;
+    int k = 1;
+    while (k <= n) {
+        __builtin_prefetch(keys + 8 * k); // the slot line three levels down
+        // keys[2k] and keys[2k+1] are demand loads from the line prefetched at
+        // k / 4, two iterations ago (keys + 8 * (k / 4)); what gets prefetched
+        // here is the key data they point to, compared one iteration from now
+        if (2 * k + 1 <= n) {
+            __builtin_prefetch(keys[2 * k]);
+            __builtin_prefetch(keys[2 * k + 1]);
+        }
+        k = 2 * k + (frozen->compare(keys[k], data) < 0);
+    }
+    k >>= __builtin_ffs(~k); // undo the trailing right turns
+    return k ? keys[k] : NULL;
+}
+
+void *frozen_search(const frozen_tree *frozen, const void *data) {
+    void *candidate = frozen_lower_bound(frozen, data);
+    if (candidate && frozen->compare(candidate, data) == 0) return candidate;
+    return NULL;
+}
+
+void free_frozen(frozen_tree *frozen) {
+    free(frozen);
+}
@@ -0,0 +1,181 @@
+#ifndef TYPED_AVL_H
+#define TYPED_AVL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Type-specialized AVL generator. Keys are stored inline in the node and the
+// comparison is an expression over `a` and `b` (negative / zero / positive),
+// so the compiler inlines it instead of calling through tree->compare.
+//
+//   DEFINE_AVL(int_avl, int, AVL_CMP_NUM(a, b))
+//   int_avl_tree *t = int_avl_create();
+//   int_avl_insert(t, 42, payload);
+//   int_avl_node *n = int_avl_search(t, 42);
+//   int_avl_free(t);
+
+#define AVL_CMP_NUM(a, b) (((a) > (b)) - ((a) < (b)))
+
+#define DEFINE_AVL(name, key_type, cmp_expr) \
+\
+typedef struct name##_node_struct { \
+    key_type key; \
+    void *data; \
+    struct name##_node_struct *left; \
+    struct name##_node_struct *right; \
+    int height; \
+} name##_node; \
+\
+typedef struct name##_tree_struct { \
+    int size; \
+    name##_node *root; \
+} name##_tree; \
+\
+static inline int name##_cmp(key_type a, key_type b) { \
+    return (cmp_expr); \
+} \
+\
+static inline name##_tree *name##_create(void) { \
+    name##_tree *tree_obj = (name##_tree *)malloc(sizeof(name##_tree)); \
+    if (!tree_obj) { \
+        perror("Failed to allocate memory for tree"); \
+        return NULL; \
+    } \
+    tree_obj->size = 0; \
+    tree_obj->root = NULL; \
+    return tree_obj; \
+} \
+\
+static inline int name##_height(const name##_node *node_obj) { \
+    return node_obj ? node_obj->height : 0; \
+} \
+\
+static inline void name##_update(name##_node *node_obj) { \
+    int hl = name##_height(node_obj->left); \
+    int hr = name##_height(node_obj->right); \
+    node_obj->height = 1 + (hl > hr ? hl : hr); \
+} \
+\
+static inline name##_node *name##_rotate_right(name##_node *current) { \
+    name##_node *B = current->left; \
+    current->left = B->right; \
+    B->right = current; \
+    name##_update(current); \
+    name##_update(B); \
+    return B; \
+} \
+\
+static inline name##_node *name##_rotate_left(name##_node *current) { \
+    name##_node *B = current->right; \
+    current->right = B->left; \
+    B->left = current; \
+    name##_update(current); \
+    name##_update(B); \
+    return B; \
+} \
+\
+static inline name##_node *name##_rebalance(name##_node *current) { \
+    name##_update(current); \
+    int bf = name##_height(current->left) - name##_height(current->right); \
+    if (bf > 1) { /* left heavy */ \
+        if (name##_height(current->left->left) < name##_height(current->left->right)) { \
+            current->left = name##_rotate_left(current->left); \
+        } \
+        return name##_rotate_right(current); \
+    } else if (bf < -1) { /* right heavy */ \
+        if (name##_height(current->right->right) < name##_height(current->right->left)) { \
+            current->right = name##_rotate_right(current->right); \
+        } \
+        return name##_rotate_left(current); \
+    } \
+    return current; \
+} \
+\
+static inline name##_node *name##_insert_node(name##_tree *tree_obj, name##_node *current, key_type key, void *data, bool *inserted) { \
+    if (!current) { \
+        name##_node *new_node = (name##_node *)malloc(sizeof(name##_node)); \
+        if (!new_node) { \
+            perror("Failed to allocate memory for node"); \
+            return NULL; \
+        } \
+        new_node->key = key; \
+        new_node->data = data; \
+        new_node->left = NULL; \
+        new_node->right = NULL; \
+        new_node->height = 1; \
+        tree_obj->size++; \
+        *inserted = true; \
+        return new_node; \
+    } \
+    int comparison = name##_cmp(key, current->key); \
+    if (comparison < 0) { \
+        current->left = name##_insert_node(tree_obj, current->left, key, data, inserted); \
+    } else if (comparison > 0) { \
+        current->right = name##_insert_node(tree_obj, current->right, key, data, inserted); \
+    } else { \
+        return current; /* duplicate key, tree unchanged */ \
+    } \
+    return name##_rebalance(current); \
+} \
+\
+static inline bool name##_insert(name##_tree *tree_obj, key_type key, void *data) { \
+    bool inserted = false; \
+    tree_obj->root = name##_insert_node(tree_obj, tree_obj->root, key, data, &inserted); \
+    return inserted; \
+} \
+\
+static inline name##_node *name##_search(const name##_tree *tree_obj, key_type key) { \
+    name##_node *current = tree_obj->root; \
+    while (current) { \
+        int comparison = name##_cmp(key, current->key); \
+        if (comparison == 0) return current; \
+        current = comparison < 0 ? current->left : current->right; \
+    } \
+    return NULL; \
+} \
+\
+static inline name##_node *name##_delete_node(name##_tree *tree_obj, name##_node *current, key_type key, bool *deleted) { \
+    if (!current) return NULL; \
+    int comparison = name##_cmp(key, current->key); \
+    if (comparison < 0) { \
+        current->left = name##_delete_node(tree_obj, current->left, key, deleted); \
+    } else if (comparison > 0) { \
+        current->right = name##_delete_node(tree_obj, current->right, key, deleted); \
+    } else { \
+        if (!current->left || !current->right) { \
+            name##_node *child = current->left ? current->left : current->right; \
+            free(current); \
+            tree_obj->size--; \
+            *deleted = true; \
+            return child; \
+        } \
+        name##_node *succ = current->right; /* two children: pull up the successor */ \
+        while (succ->left) succ = succ->left; \
+        current->key = succ->key; \
+        current->data = succ->data; \
+        current->right = name##_delete_node(tree_obj, current->right, succ->key, deleted); \
+    } \
+    return name##_rebalance(current); \
+} \
+\
+static inline bool name##_delete(name##_tree *tree_obj, key_type key) { \
+    bool deleted = false; \
+    tree_obj->root = name##_delete_node(tree_obj, tree_obj->root, key, &deleted); \
+    return deleted; \
+} \
+\
+static inline void name##_free_nodes(name##_node *current) { \
+    if (!current) return; \
+    name##_free_nodes(current->left); \
+    name##_free_nodes(current->right); \
+    free(current); \
+} \
+\
+static inline void name##_free(name##_tree *tree_obj) { \
+    if (!tree_obj) return; \
+    name##_free_nodes(tree_obj->root); \
+    free(tree_obj); \
+}
+
+#endif
@@ -6,6 +6,13 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define SEARCH_BATCH_GROUP 16 // lookups advanced in lockstep by search_batch
+#define PARALLEL_BUILD_MIN (1 << 20) // build_tree_from_array sorts and builds on all cores from here
+#define PARALLEL_SORT_CUTOFF 16384 // smaller sort/merge/build ranges stay on one thread
+#define ITER_MAX_DEPTH 64 // pending ancestors a cursor holds before dropping the shallowest
 
 typedef struct node_struct {
     void *data;
@@ -14,15 +21,50 @@ typedef struct node_struct {
     int height; 
 } node;
 
+typedef struct node_block_struct {
+    struct node_block_struct *next;
+    int used;
+    node nodes[];
+} node_block;
+
+typedef struct node_arena_struct {
+    node_block *blocks;
+    node *free_list; // released nodes, chained through ->left
+    int nodes_per_block;
+} node_arena;
+
 typedef struct tree_struct {
     int size;
     int (*compare)(const void *data1, const void *data2);
     void (*print_func)(const void *data);
     node *root;
+    node_arena *arena; // NULL -> nodes come from malloc
+    node ***path; // scratch stack of child links for insert/delete retracing
+    int path_cap;
 } tree;
 
+// In-order cursor. path holds only the pending ancestors: the ones current
+// sits left of (successors still to come) when moving forward, or right of
+// when moving backward, so a right chain scanned forward keeps it at depth 1.
+// Changing direction re-descends from the root once. On a spine with more
+// than ITER_MAX_DEPTH pending ancestors the shallowest ones are dropped
+// (path is a ring) and rebuilt by one descent when the rest run out.
+typedef struct tree_iter_struct {
+    const tree *tree_obj;
+    node *current; // NULL once the cursor runs off either end
+    bool reverse;  // path holds predecessors (iter_prev) rather than successors
+    bool overflow; // shallower pending ancestors were dropped
+    int base;      // ring start
+    int depth;
+    node *path[ITER_MAX_DEPTH];
+} tree_iter;
+
 tree *create_tree(int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *create_tree_with_arena(int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int nodes_per_block);
 tree *build_tree_from_array(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *build_tree_parallel(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int threads);
+void serial_merge(void **a, size_t na, void **b, size_t nb, void **out, int (*compare)(const void *, const void *));
+void serial_merge_sort(void **a, void **tmp, size_t n, int (*compare)(const void *, const void *));
 void insert(tree *tree_obj, void *data);
 bool search(tree *tree_obj, const void *data);
 void delete_tree(tree *tree_obj, void *data);
@@ -37,12 +79,32 @@ void update_height(node *node_obj);
 int get_size_tree(const tree *tree_obj);
 node *insert_node(tree *tree_obj, node *current, void *data_obj);
 node *search_node(tree *tree_obj, node *current, const void *data_obj);
-node *delete_node_recursive(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
+void search_batch(tree *tree_obj, const void **keys, size_t n, void **out);
+node *find(const tree *tree_obj, const void *key);
+node *lower_bound(const tree *tree_obj, const void *key);
+node *upper_bound(const tree *tree_obj, const void *key);
+node *find_floor(const tree *tree_obj, const void *key);
+node *find_ceiling(const tree *tree_obj, const void *key);
+node *predecessor(const tree *tree_obj, const void *key);
+node *successor(const tree *tree_obj, const void *key);
+node *min_node(const tree *tree_obj);
+node *max_node(const tree *tree_obj);
+node *iter_begin(tree_iter *it, const tree *tree_obj);
+node *iter_last(tree_iter *it, const tree *tree_obj);
+node *iter_seek(tree_iter *it, const tree *tree_obj, const void *key);
+node *iter_next(tree_iter *it);
+node *iter_prev(tree_iter *it);
+node *delete_node_iterative(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
+bool reserve_path(tree *tree_obj, int depth);
 node *find_min(node *current);
 void display_tree_recursive(tree *tree_obj, node *parent, const char *prefix, bool is_left, int depth);
 void preorder_recursive(node *current, void **nodes, int *i);
 void inorder_recursive(node *current, void **nodes, int *i);
 void postorder_recursive(node *current, void **nodes, int *i);
-void free_nodes_recursive(node *current);
+void free_nodes(node *current);
+node_arena *arena_create(int nodes_per_block);
+void arena_destroy(node_arena *arena);
+node *node_alloc(tree *tree_obj);
+void node_release(tree *tree_obj, node *node_obj);
 
 #endif
\ No newline at end of file
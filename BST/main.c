@@ -26,7 +26,107 @@ void print_double(const void *data) {
     printf("%.2f", *(double *)data);
 }
 
-int main() {
+// Random lookups of present keys: one search_node descent at a time against
+// search_batch, which overlaps the cache misses of SEARCH_BATCH_GROUP lookups
+void bench_search_batch(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements);
+    const void **probes = (const void **)malloc(sizeof(void *) * num_elements);
+    void **out = (void **)malloc(sizeof(void *) * num_elements);
+    srand(42);
+    tree *searched = create_tree(compare_int, print_int);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand();
+        insert(searched, &keys[i]);
+    }
+    for (int i = 0; i < num_elements; i++) {
+        probes[i] = &keys[rand() % num_elements];
+    }
+    clock_t start = clock();
+    int found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        found += search_node(searched, searched->root, probes[i]) != NULL;
+    }
+    double single_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    search_batch(searched, probes, num_elements, out);
+    double batch_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    int batch_found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        batch_found += out[i] != NULL;
+    }
+    printf("%s: %d lookups in a tree of %d, search_node %.2f ms (%d found), search_batch %.2f ms (%d found)\n",
+           "BST", num_elements, get_size_tree(searched), single_ms, found, batch_ms, batch_found);
+    free_tree(searched);
+    free(out);
+    free(probes);
+    free(keys);
+}
+
+// Unsorted ingest: insert loop against the parallel sort-then-build path
+void bench_parallel_build(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements);
+    void **ptrs = (void **)malloc(sizeof(void *) * num_elements);
+    srand(42);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand();
+        ptrs[i] = &keys[i];
+    }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    tree *inserted = create_tree(compare_int, print_int);
+    for (int i = 0; i < num_elements; i++) {
+        insert(inserted, ptrs[i]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double insert_ms = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    free_tree(inserted);
+    printf("%s: insert loop of %d in %.2f ms\n", "BST", num_elements, insert_ms);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int threads = 1; threads <= cpus; threads *= 2) { // wall clock, so clock() would sum the threads
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        tree *built = build_tree_parallel(ptrs, num_elements, compare_int, print_int, threads);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double build_ms = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1e6;
+        printf("%s: parallel build on %2d threads in %.2f ms (size %d, height %d)\n",
+               "BST", threads, build_ms, get_size_tree(built), get_height(built->root));
+        free_tree(built);
+    }
+    free(ptrs);
+    free(keys);
+}
+
+// Sorted input degenerates the tree into a right chain far deeper than
+// ITER_MAX_DEPTH; both scan directions must still visit every key in order.
+void test_cursor_sorted(int num_elements) {
+    int *keys = (int *)malloc(sizeof(int) * num_elements);
+    tree *chain = create_tree(compare_int, print_int);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i;
+        insert(chain, &keys[i]);
+    }
+    tree_iter cursor;
+    int forward = 0, backward = 0;
+    bool ordered = true;
+    for (node *it_node = iter_begin(&cursor, chain); it_node; it_node = iter_next(&cursor)) {
+        ordered &= *(int *)it_node->data == forward++;
+    }
+    for (node *it_node = iter_last(&cursor, chain); it_node; it_node = iter_prev(&cursor)) {
+        ordered &= *(int *)it_node->data == num_elements - 1 - backward++;
+    }
+    printf("Cursor over %d sorted-inserted keys: %d forward, %d backward, %s\n\n",
+           num_elements, forward, backward, ordered && forward == num_elements && backward == num_elements ? "in order" : "MISMATCH");
+    free_tree(chain);
+    free(keys);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) { // ./gen_bst bench [elements]
+        int num_elements = argc > 2 ? atoi(argv[2]) : 1000000;
+        bench_search_batch(num_elements);
+        bench_parallel_build(num_elements);
+        return 0;
+    }
     srand(time(NULL)); 
     printf("TESTING BINARY SEARCH TREE WITH INTEGERS\n\n");
 
@@ -65,6 +165,39 @@ int main() {
     search(int_tree, &not_in_tree);
     printf("\n");
 
+    void *batch_out[NUM_INTS];
+    search_batch(int_tree, (const void **)generic_ptr_int, NUM_INTS, batch_out);
+    int batch_found = 0;
+    for (int i = 0; i < NUM_INTS; i++) {
+        batch_found += batch_out[i] != NULL;
+    }
+    printf("Batch search found %d of %d generated values\n\n", batch_found, NUM_INTS);
+
+    int probe = 500;
+    node *lo = find_floor(int_tree, &probe);
+    node *hi = find_ceiling(int_tree, &probe);
+    node *below = predecessor(int_tree, &probe);
+    node *above = successor(int_tree, &probe);
+    printf("Around %d: floor %d, ceiling %d, predecessor %d, successor %d\n", probe,
+           lo ? *(int *)lo->data : -1, hi ? *(int *)hi->data : -1,
+           below ? *(int *)below->data : -1, above ? *(int *)above->data : -1);
+    printf("Min %d, max %d, find(%d) %s\n\n", *(int *)min_node(int_tree)->data, *(int *)max_node(int_tree)->data,
+           *int_data[3], find(int_tree, int_data[3]) ? "hit" : "miss");
+
+    tree_iter cursor;
+    printf("First 10 via cursor:");
+    int shown = 0;
+    for (node *it_node = iter_begin(&cursor, int_tree); it_node && shown < 10; it_node = iter_next(&cursor), shown++) {
+        printf(" %d", *(int *)it_node->data);
+    }
+    printf("\nValues in [%d, %d) via iter_seek:", probe, probe + 50);
+    int range_end = probe + 50;
+    for (node *it_node = iter_seek(&cursor, int_tree, &probe); it_node && compare_int(it_node->data, &range_end) < 0; it_node = iter_next(&cursor)) {
+        printf(" %d", *(int *)it_node->data);
+    }
+    printf("\n\n");
+    test_cursor_sorted(5000);
+
     printf("Deleting node with value: %d\n", *int_data[2]);
     delete_tree(int_tree, int_data[2]);
     printf("Deleting node with value: %d\n", *int_data[5]);
@@ -97,6 +230,18 @@ int main() {
     printf("\n");
 
 
+    printf("\nTESTING ARENA-BACKED TREE WITH INTEGERS\n\n");
+
+    tree *arena_tree = create_tree_with_arena(compare_int, print_int, 64);
+    for (int i = 0; i < NUM_INTS; i++) {
+        insert(arena_tree, int_data[i]);
+    }
+    printf("Arena tree size after inserts: %d\n", get_size_tree(arena_tree));
+    delete_tree(arena_tree, int_data[7]);
+    insert(arena_tree, int_data[7]); // reuses the released slot
+    printf("Arena tree size after delete/reinsert: %d\n\n", get_size_tree(arena_tree));
+    free_tree(arena_tree);
+
     printf("Cleaning up memory\n");
     
     for (int i = 0; i < NUM_INTS; i++) {
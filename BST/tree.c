@@ -1,7 +1,11 @@
 #include "header.h"
 
 tree *create_tree(int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *create_tree_with_arena(int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int nodes_per_block);
 tree *build_tree_from_array(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *));
+tree *build_tree_parallel(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int threads);
+void serial_merge(void **a, size_t na, void **b, size_t nb, void **out, int (*compare)(const void *, const void *));
+void serial_merge_sort(void **a, void **tmp, size_t n, int (*compare)(const void *, const void *));
 void insert(tree *tree_obj, void *data);
 bool search(tree *tree_obj, const void *data);
 void delete_tree(tree *tree_obj, void *data);
@@ -16,13 +20,33 @@ void update_height(node *node_obj);
 int get_size_tree(const tree *tree_obj);
 node *insert_node(tree *tree_obj, node *current, void *data_obj);
 node *search_node(tree *tree_obj, node *current, const void *data_obj);
-node *delete_node_recursive(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
+void search_batch(tree *tree_obj, const void **keys, size_t n, void **out);
+node *find(const tree *tree_obj, const void *key);
+node *lower_bound(const tree *tree_obj, const void *key);
+node *upper_bound(const tree *tree_obj, const void *key);
+node *find_floor(const tree *tree_obj, const void *key);
+node *find_ceiling(const tree *tree_obj, const void *key);
+node *predecessor(const tree *tree_obj, const void *key);
+node *successor(const tree *tree_obj, const void *key);
+node *min_node(const tree *tree_obj);
+node *max_node(const tree *tree_obj);
+node *iter_begin(tree_iter *it, const tree *tree_obj);
+node *iter_last(tree_iter *it, const tree *tree_obj);
+node *iter_seek(tree_iter *it, const tree *tree_obj, const void *key);
+node *iter_next(tree_iter *it);
+node *iter_prev(tree_iter *it);
+node *delete_node_iterative(tree *tree_obj, node *current, const void *data_obj, bool *deleted);
+bool reserve_path(tree *tree_obj, int depth);
 node *find_min(node *current);
 void display_tree_recursive(tree *tree_obj, node *parent, const char *prefix, bool is_left, int depth);
 void preorder_recursive(node *current, void **nodes, int *i);
 void inorder_recursive(node *current, void **nodes, int *i);
 void postorder_recursive(node *current, void **nodes, int *i);
-void free_nodes_recursive(node *current);
+void free_nodes(node *current);
+node_arena *arena_create(int nodes_per_block);
+void arena_destroy(node_arena *arena);
+node *node_alloc(tree *tree_obj);
+void node_release(tree *tree_obj, node *node_obj);
 
 
 
@@ -49,10 +73,85 @@ tree *create_tree(int (*compare_func)(const void *, const void *), void (*print_
     tree_obj->size = 0;
     tree_obj->compare = compare_func;
     tree_obj->print_func = print_func;
+    tree_obj->arena = NULL;
+    tree_obj->path = NULL;
+    tree_obj->path_cap = 0;
     return tree_obj;
 }
 
+tree *create_tree_with_arena(int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int nodes_per_block) {
+    tree *tree_obj = create_tree(compare_func, print_func);
+    if (!tree_obj) return NULL;
+    tree_obj->arena = arena_create(nodes_per_block);
+    if (!tree_obj->arena) {
+        free(tree_obj->path);
+        free(tree_obj);
+        return NULL;
+    }
+    return tree_obj;
+}
+
+node_arena *arena_create(int nodes_per_block) {
+    node_arena *arena = (node_arena *)malloc(sizeof(node_arena));
+    if (!arena) {
+        perror("Failed to allocate memory for node arena");
+        return NULL;
+    }
+    arena->blocks = NULL;
+    arena->free_list = NULL;
+    arena->nodes_per_block = nodes_per_block > 0 ? nodes_per_block : 1024;
+    return arena;
+}
+
+void arena_destroy(node_arena *arena) {
+    if (!arena) return;
+    node_block *block = arena->blocks;
+    while (block) { // one free per block, nodes are never walked
+        node_block *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+node *node_alloc(tree *tree_obj) {
+    node_arena *arena = tree_obj->arena;
+    if (!arena) {
+        return (node *)malloc(sizeof(node));
+    }
+    if (arena->free_list) { // reuse a released slot first
+        node *reused = arena->free_list;
+        arena->free_list = reused->left;
+        return reused;
+    }
+    node_block *block = arena->blocks;
+    if (!block || block->used == arena->nodes_per_block) {
+        block = (node_block *)malloc(sizeof(node_block) + sizeof(node) * arena->nodes_per_block);
+        if (!block) {
+            perror("Failed to allocate node block");
+            return NULL;
+        }
+        block->used = 0;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+    return &block->nodes[block->used++];
+}
+
+void node_release(tree *tree_obj, node *node_obj) {
+    node_arena *arena = tree_obj->arena;
+    if (!arena) {
+        free(node_obj);
+        return;
+    }
+    node_obj->left = arena->free_list;
+    arena->free_list = node_obj;
+}
+
 tree *build_tree_from_array(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *)) {
+    if (size >= PARALLEL_BUILD_MIN) {
+        return build_tree_parallel(data, size, compare_func, print_func, 0);
+    }
     tree *tree_obj = create_tree(compare_func, print_func);
     if (!tree_obj) return NULL;
     
@@ -62,32 +161,279 @@ tree *build_tree_from_array(void **data, int size, int (*compare_func)(const voi
     return tree_obj;
 }
 
+// Parallel sort-then-build. Work is split fork-join style: a task with more
+// than one thread to spend hands half its range (and half its threads) to a
+// new pthread, does the other half itself and joins. If pthread_create fails
+// the half just runs inline.
+
+// stable: on ties the element from a wins
+void serial_merge(void **a, size_t na, void **b, size_t nb, void **out, int (*compare)(const void *, const void *)) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        out[k++] = compare(a[i], b[j]) <= 0 ? a[i++] : b[j++];
+    }
+    while (i < na) out[k++] = a[i++];
+    while (j < nb) out[k++] = b[j++];
+}
+
+// sorts a in place, tmp is scratch of the same length
+void serial_merge_sort(void **a, void **tmp, size_t n, int (*compare)(const void *, const void *)) {
+    if (n <= 16) { // insertion sort, stable
+        for (size_t i = 1; i < n; i++) {
+            void *item = a[i];
+            size_t j = i;
+            while (j > 0 && compare(a[j-1], item) > 0) {
+                a[j] = a[j-1];
+                j--;
+            }
+            a[j] = item;
+        }
+        return;
+    }
+    size_t half = n / 2;
+    serial_merge_sort(a, tmp, half, compare);
+    serial_merge_sort(a + half, tmp + half, n - half, compare);
+    serial_merge(a, half, a + half, n - half, tmp, compare);
+    memcpy(a, tmp, sizeof(void *) * n);
+}
+
+typedef struct merge_task_struct {
+    void **a, **b, **out;
+    size_t na, nb;
+    int (*compare)(const void *, const void *);
+    int threads;
+} merge_task;
+
+// first index in a[0..n) whose element is > key (upper) or >= key (!upper)
+static size_t merge_bound(void **a, size_t n, const void *key, bool upper, int (*compare)(const void *, const void *)) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = compare(a[mid], key);
+        if (c < 0 || (upper && c == 0)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void *merge_task_run(void *arg);
+
+// Splits the longer run at its middle and the other run at the matching
+// bound, so both halves merge independently and ties still favour a.
+void parallel_merge(merge_task *task) {
+    size_t na = task->na, nb = task->nb;
+    if (task->threads <= 1 || na + nb < PARALLEL_SORT_CUTOFF) {
+        serial_merge(task->a, na, task->b, nb, task->out, task->compare);
+        return;
+    }
+    size_t ma, mb;
+    if (na >= nb) {
+        ma = na / 2;
+        mb = merge_bound(task->b, nb, task->a[ma], false, task->compare);
+    } else {
+        mb = nb / 2;
+        ma = merge_bound(task->a, na, task->b[mb], true, task->compare);
+    }
+    merge_task left = {task->a, task->b, task->out, ma, mb, task->compare, task->threads / 2};
+    merge_task right = {task->a + ma, task->b + mb, task->out + ma + mb, na - ma, nb - mb, task->compare, task->threads - task->threads / 2};
+    pthread_t worker;
+    bool forked = pthread_create(&worker, NULL, merge_task_run, &left) == 0;
+    if (!forked) parallel_merge(&left);
+    parallel_merge(&right);
+    if (forked) pthread_join(worker, NULL);
+}
+
+static void *merge_task_run(void *arg) {
+    parallel_merge((merge_task *)arg);
+    return NULL;
+}
+
+typedef struct sort_task_struct {
+    void **a, **tmp;
+    size_t n;
+    bool into_tmp; // result lands in tmp instead of a
+    int (*compare)(const void *, const void *);
+    int threads;
+} sort_task;
+
+static void *sort_task_run(void *arg);
+
+// The halves are sorted into the opposite buffer and merged back into the
+// target, so no level pays for a serial copy.
+void parallel_merge_sort(sort_task *task) {
+    if (task->threads <= 1 || task->n < PARALLEL_SORT_CUTOFF) {
+        serial_merge_sort(task->a, task->tmp, task->n, task->compare);
+        if (task->into_tmp) memcpy(task->tmp, task->a, sizeof(void *) * task->n);
+        return;
+    }
+    size_t half = task->n / 2;
+    sort_task left = {task->a, task->tmp, half, !task->into_tmp, task->compare, task->threads / 2};
+    sort_task right = {task->a + half, task->tmp + half, task->n - half, !task->into_tmp, task->compare, task->threads - task->threads / 2};
+    pthread_t worker;
+    bool forked = pthread_create(&worker, NULL, sort_task_run, &left) == 0;
+    if (!forked) parallel_merge_sort(&left);
+    parallel_merge_sort(&right);
+    if (forked) pthread_join(worker, NULL);
+    void **src = task->into_tmp ? task->a : task->tmp;
+    void **dst = task->into_tmp ? task->tmp : task->a;
+    merge_task merge = {src, src + half, dst, half, task->n - half, task->compare, task->threads};
+    parallel_merge(&merge);
+}
+
+static void *sort_task_run(void *arg) {
+    parallel_merge_sort((sort_task *)arg);
+    return NULL;
+}
+
+typedef struct build_task_struct {
+    void **data;
+    int lo, hi;
+    int threads;
+    bool failed;
+    node *root;
+} build_task;
+
+static void *build_task_run(void *arg);
+
+// balanced subtree over sorted, distinct data[lo..hi]; each task keeps its own
+// failure flag so forked halves never write shared state
+void build_parallel_range(build_task *task) {
+    if (task->lo > task->hi) {
+        task->root = NULL;
+        return;
+    }
+    int mid = task->lo + (task->hi - task->lo) / 2;
+    node *node_obj = (node *)malloc(sizeof(node));
+    if (!node_obj) {
+        task->failed = true;
+        task->root = NULL;
+        return;
+    }
+    node_obj->data = task->data[mid];
+    build_task left = {task->data, task->lo, mid - 1, task->threads / 2, false, NULL};
+    build_task right = {task->data, mid + 1, task->hi, task->threads - task->threads / 2, false, NULL};
+    pthread_t worker;
+    bool forked = false;
+    if (task->threads > 1 && task->hi - task->lo >= PARALLEL_SORT_CUTOFF) {
+        forked = pthread_create(&worker, NULL, build_task_run, &left) == 0;
+    }
+    if (!forked) {
+        left.threads = right.threads = 1;
+        build_parallel_range(&left);
+    }
+    build_parallel_range(&right);
+    if (forked) pthread_join(worker, NULL);
+    node_obj->left = left.root;
+    node_obj->right = right.root;
+    update_height(node_obj);
+    task->failed = left.failed || right.failed;
+    task->root = node_obj;
+}
+
+static void *build_task_run(void *arg) {
+    build_parallel_range((build_task *)arg);
+    return NULL;
+}
+
+// Sorts a copy of data on up to `threads` threads (<= 0: one per online CPU),
+// drops duplicates keeping the first of each run like insert does, and builds
+// a perfectly balanced tree with subtrees on separate threads.
+tree *build_tree_parallel(void **data, int size, int (*compare_func)(const void *, const void *), void (*print_func)(const void *), int threads) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    tree *tree_obj = create_tree(compare_func, print_func);
+    if (!tree_obj || size <= 0) return tree_obj;
+    void **sorted = (void **)malloc(sizeof(void *) * size);
+    void **tmp = (void **)malloc(sizeof(void *) * size);
+    if (!sorted || !tmp) {
+        perror("Failed to allocate memory for parallel build");
+        free(sorted);
+        free(tmp);
+        free_tree(tree_obj);
+        return NULL;
+    }
+    memcpy(sorted, data, sizeof(void *) * size);
+    sort_task sort = {sorted, tmp, (size_t)size, false, compare_func, threads};
+    parallel_merge_sort(&sort);
+    free(tmp);
+
+    int count = 1;
+    for (int i = 1; i < size; i++) {
+        if (compare_func(sorted[count-1], sorted[i]) != 0) {
+            sorted[count++] = sorted[i];
+        }
+    }
+    build_task build = {sorted, 0, count - 1, threads, false, NULL};
+    build_parallel_range(&build);
+    free(sorted);
+    tree_obj->root = build.root;
+    if (build.failed) {
+        perror("Failed to allocate memory for node");
+        free_tree(tree_obj);
+        return NULL;
+    }
+    tree_obj->size = count;
+    return tree_obj;
+}
+
 void insert(tree *tree_obj , void *data) {
     tree_obj->root = insert_node(tree_obj, tree_obj->root, data);
 }
 
 void update_height(node *node_obj) {
     if (node_obj) {
-        node_obj->height = 1 + fmax(get_height(node_obj->left), get_height(node_obj->right));
+        int left = get_height(node_obj->left);
+        int right = get_height(node_obj->right);
+        node_obj->height = 1 + (left > right ? left : right);
+    }
+}
+
+// An unbalanced BST can be as deep as it is large, so the path stack grows on demand.
+bool reserve_path(tree *tree_obj, int depth) {
+    if (depth < tree_obj->path_cap) return true;
+    int new_cap = tree_obj->path_cap ? tree_obj->path_cap * 2 : 64;
+    node ***new_path = (node ***)realloc(tree_obj->path, sizeof(node **) * new_cap);
+    if (!new_path) {
+        perror("Failed to grow tree path stack");
+        return false;
     }
+    tree_obj->path = new_path;
+    tree_obj->path_cap = new_cap;
+    return true;
 }
 
 node *insert_node(tree *tree_obj, node *current, void *data_obj) {
-    if (!current) {
-        node *new_node = (node *)malloc(sizeof(node));
-        new_node->data = data_obj;
-        new_node->left = NULL;
-        new_node->right = NULL;
-        new_node->height = 1; // Leaf node has height 1
-        tree_obj->size++;
-        return new_node;
-    } if (tree_obj->compare(data_obj, current->data) < 0) {
-        current->left = insert_node(tree_obj, current->left, data_obj);
-    } else if (tree_obj->compare(data_obj, current->data) > 0) {
-        current->right = insert_node(tree_obj, current->right, data_obj);
-    } 
-    update_height(current);
-    return current;
+    node *root = current;
+    node **link = &root;
+    int depth = 0;
+    while (*link) {
+        int comparison = tree_obj->compare(data_obj, (*link)->data);
+        if (comparison == 0) return root; // already present
+        if (!reserve_path(tree_obj, depth)) return root;
+        tree_obj->path[depth++] = link;
+        link = comparison < 0 ? &(*link)->left : &(*link)->right;
+    }
+    node *new_node = node_alloc(tree_obj);
+    if (!new_node) return root;
+    new_node->data = data_obj;
+    new_node->left = NULL;
+    new_node->right = NULL;
+    new_node->height = 1; // Leaf node has height 1
+    *link = new_node;
+    tree_obj->size++;
+
+    for (int i = depth - 1; i >= 0; i--) { // heights above an unchanged node are unchanged too
+        node *ancestor = *tree_obj->path[i];
+        int old_height = ancestor->height;
+        update_height(ancestor);
+        if (ancestor->height == old_height) break;
+    }
+    return root;
 }
 
 bool search(tree *tree_obj, const void *data) {
@@ -107,18 +453,50 @@ bool search(tree *tree_obj, const void *data) {
 }
 
 node *search_node(tree *tree_obj, node *current, const void *data_obj) {
-    if (current == NULL) {
-        return NULL; // Data not found
+    while (current) {
+        int comparison = tree_obj->compare(data_obj, current->data);
+        if (comparison == 0) return current;
+        current = comparison < 0 ? current->left : current->right;
     }
-    
-    int comparison = tree_obj->compare(data_obj, current->data);
-    
-    if (comparison == 0) {
-        return current;
-    } else if (comparison < 0) {
-        return search_node(tree_obj, current->left, data_obj);
-    } else {
-        return search_node(tree_obj, current->right, data_obj);
+    return NULL; // Data not found
+}
+
+// Group prefetching: SEARCH_BATCH_GROUP lookups descend one level per round.
+// Each round first touches every cursor's data (its node was prefetched a
+// round earlier), then compares and prefetches the next child, so the cache
+// misses of the whole group overlap instead of serialising.
+void search_batch(tree *tree_obj, const void **keys, size_t n, void **out) {
+    node *cursor[SEARCH_BATCH_GROUP];
+    for (size_t base = 0; base < n; base += SEARCH_BATCH_GROUP) {
+        int group = n - base < SEARCH_BATCH_GROUP ? (int)(n - base) : SEARCH_BATCH_GROUP;
+        int active = tree_obj->root ? group : 0;
+        for (int i = 0; i < group; i++) {
+            cursor[i] = tree_obj->root;
+            out[base + i] = NULL;
+        }
+        while (active > 0) {
+            for (int i = 0; i < group; i++) {
+                if (cursor[i]) __builtin_prefetch(cursor[i]->data);
+            }
+            for (int i = 0; i < group; i++) {
+                node *current = cursor[i];
+                if (!current) continue;
+                int comparison = tree_obj->compare(keys[base + i], current->data);
+                if (comparison == 0) {
+                    out[base + i] = current->data;
+                    cursor[i] = NULL;
+                    active--;
+                    continue;
+                }
+                node *next = comparison < 0 ? current->left : current->right;
+                cursor[i] = next;
+                if (next) {
+                    __builtin_prefetch(next);
+                } else {
+                    active--;
+                }
+            }
+        }
     }
 }
 
@@ -134,45 +512,244 @@ node *find_min(node *current) {
     return current;
 }
 
+// Silent query family. Each is one root-to-leaf pass with a single compare
+// per level; the bounds remember the last node on the qualifying side.
+node *find(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root;
+    while (current) {
+        int comparison = tree_obj->compare(key, current->data);
+        if (comparison == 0) return current;
+        current = comparison < 0 ? current->left : current->right;
+    }
+    return NULL;
+}
+
+// Smallest node >= key
+node *lower_bound(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) <= 0) {
+            best = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return best;
+}
+
+// Smallest node > key
+node *upper_bound(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) < 0) {
+            best = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return best;
+}
+
+// Largest node <= key
+node *find_floor(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) >= 0) {
+            best = current;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return best;
+}
+
+node *find_ceiling(const tree *tree_obj, const void *key) {
+    return lower_bound(tree_obj, key);
+}
+
+// Largest node < key (key need not be in the tree)
+node *predecessor(const tree *tree_obj, const void *key) {
+    node *current = tree_obj->root, *best = NULL;
+    while (current) {
+        if (tree_obj->compare(key, current->data) > 0) {
+            best = current;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return best;
+}
+
+// Smallest node > key (key need not be in the tree)
+node *successor(const tree *tree_obj, const void *key) {
+    return upper_bound(tree_obj, key);
+}
+
+node *min_node(const tree *tree_obj) {
+    return tree_obj->root ? find_min(tree_obj->root) : NULL;
+}
+
+node *max_node(const tree *tree_obj) {
+    node *current = tree_obj->root;
+    if (!current) return NULL;
+    while (current->right) current = current->right;
+    return current;
+}
+
+static void iter_push(tree_iter *it, node *node_obj) {
+    if (it->depth == ITER_MAX_DEPTH) { // drop the shallowest
+        it->base = (it->base + 1) % ITER_MAX_DEPTH;
+        it->depth--;
+        it->overflow = true;
+    }
+    it->path[(it->base + it->depth++) % ITER_MAX_DEPTH] = node_obj;
+}
+
+static node *iter_pop(tree_iter *it) {
+    return it->path[(it->base + --it->depth) % ITER_MAX_DEPTH];
+}
+
+static void iter_reset(tree_iter *it, const tree *tree_obj, bool reverse) {
+    it->tree_obj = tree_obj;
+    it->reverse = reverse;
+    it->overflow = false;
+    it->base = 0;
+    it->depth = 0;
+}
+
+// Rebuilds the pending ancestors of current for the given direction with
+// one keyed descent from the root.
+static void iter_anchor(tree_iter *it, bool reverse) {
+    const tree *tree_obj = it->tree_obj;
+    iter_reset(it, tree_obj, reverse);
+    node *current = tree_obj->root;
+    while (current && current != it->current) {
+        int comparison = tree_obj->compare(it->current->data, current->data);
+        if (comparison < 0) {
+            if (!reverse) iter_push(it, current);
+            current = current->left;
+        } else {
+            if (reverse) iter_push(it, current);
+            current = current->right;
+        }
+    }
+}
+
+// Positions the cursor on the smallest node and returns it
+node *iter_begin(tree_iter *it, const tree *tree_obj) {
+    iter_reset(it, tree_obj, false);
+    it->current = tree_obj->root;
+    if (!it->current) return NULL;
+    while (it->current->left) {
+        iter_push(it, it->current);
+        it->current = it->current->left;
+    }
+    return it->current;
+}
+
+// Positions the cursor on the largest node, for reverse scans
+node *iter_last(tree_iter *it, const tree *tree_obj) {
+    iter_reset(it, tree_obj, true);
+    it->current = tree_obj->root;
+    if (!it->current) return NULL;
+    while (it->current->right) {
+        iter_push(it, it->current);
+        it->current = it->current->right;
+    }
+    return it->current;
+}
+
+// Positions the cursor on the first node >= key
+node *iter_seek(tree_iter *it, const tree *tree_obj, const void *key) {
+    iter_reset(it, tree_obj, false);
+    it->current = lower_bound(tree_obj, key);
+    if (it->current) iter_anchor(it, false);
+    return it->current;
+}
+
+node *iter_next(tree_iter *it) {
+    node *current = it->current;
+    if (!current) return NULL;
+    if (it->reverse) iter_anchor(it, false);
+    if (current->right) {
+        current = current->right;
+        while (current->left) {
+            iter_push(it, current);
+            current = current->left;
+        }
+        return it->current = current;
+    }
+    if (it->depth == 0 && it->overflow) iter_anchor(it, false);
+    return it->current = it->depth ? iter_pop(it) : NULL;
+}
+
+node *iter_prev(tree_iter *it) {
+    node *current = it->current;
+    if (!current) return NULL;
+    if (!it->reverse) iter_anchor(it, true);
+    if (current->left) {
+        current = current->left;
+        while (current->right) {
+            iter_push(it, current);
+            current = current->right;
+        }
+        return it->current = current;
+    }
+    if (it->depth == 0 && it->overflow) iter_anchor(it, true);
+    return it->current = it->depth ? iter_pop(it) : NULL;
+}
+
 void delete_tree(tree *tree_obj , void *data) {
     bool deleted = false;
-    tree_obj->root = delete_node_recursive(tree_obj, tree_obj->root, data, &deleted);
+    tree_obj->root = delete_node_iterative(tree_obj, tree_obj->root, data, &deleted);
     if(deleted) tree_obj->size--;
 }
 
-node *delete_node_recursive(tree *tree_obj, node *current, const void *data_obj, bool *deleted) {
-    if (current == NULL) {
-        return NULL;
+node *delete_node_iterative(tree *tree_obj, node *current, const void *data_obj, bool *deleted) {
+    node *root = current;
+    node **link = &root;
+    int depth = 0;
+    while (*link) {
+        int comparison = tree_obj->compare(data_obj, (*link)->data);
+        if (comparison == 0) break;
+        if (!reserve_path(tree_obj, depth)) return root;
+        tree_obj->path[depth++] = link;
+        link = comparison < 0 ? &(*link)->left : &(*link)->right;
     }
-    int comparison = tree_obj->compare(data_obj, current->data);
-    if (comparison < 0) {
-        current->left = delete_node_recursive(tree_obj, current->left, data_obj, deleted);
-    } else if (comparison > 0) {
-        current->right = delete_node_recursive(tree_obj, current->right, data_obj, deleted);
+    node *target = *link;
+    if (!target) return root;
+
+    if (target->left && target->right) { // two children: unlink the successor instead
+        if (!reserve_path(tree_obj, depth)) return root;
+        tree_obj->path[depth++] = link;
+        node **succ_link = &target->right;
+        while ((*succ_link)->left) {
+            if (!reserve_path(tree_obj, depth)) return root;
+            tree_obj->path[depth++] = succ_link;
+            succ_link = &(*succ_link)->left;
+        }
+        node *succ = *succ_link;
+        *deleted = true;
+        target->data = succ->data;
+        *succ_link = succ->right;
+        node_release(tree_obj, succ);
     } else {
         *deleted = true;
-        if (current->left == NULL && current->right == NULL) {
-            free(current);
-            return NULL;
-        }
-        //1 child
-        if (current->left == NULL) {
-            node *temp = current->right;
-            free(current);
-            return temp;
-        } else if (current->right == NULL) {
-            node *temp = current->left;
-            free(current);
-            return temp;
-        }
+        *link = target->left ? target->left : target->right;
+        node_release(tree_obj, target);
+    }
 
-        // two children.
-        node *temp = find_min(current->right);
-        current->data = temp->data;
-        current->right = delete_node_recursive(tree_obj, current->right, temp->data, deleted);
+    for (int i = depth - 1; i >= 0; i--) {
+        node *ancestor = *tree_obj->path[i];
+        int old_height = ancestor->height;
+        update_height(ancestor);
+        if (ancestor->height == old_height) break;
     }
-    update_height(current);
-    return current;
+    return root;
 }
 
 void display(tree *tree_obj) {
@@ -260,14 +837,29 @@ void postorder_recursive(node *current, void **nodes, int *i) {
 
 void free_tree(tree *tree_obj) {
     if(tree_obj) {
-        free_nodes_recursive(tree_obj->root);
+        if (tree_obj->arena) {
+            arena_destroy(tree_obj->arena); // O(blocks)
+        } else {
+            free_nodes(tree_obj->root);
+        }
+        free(tree_obj->path);
         free(tree_obj);
     }
 }
 
-void free_nodes_recursive(node *current) {
-    if(!current) return;
-    free_nodes_recursive(current->left);
-    free_nodes_recursive(current->right);
-    free(current);
-} 
\ No newline at end of file
+// Flattens left spines with right rotations as it goes, so a degenerate
+// (sorted-input) tree is freed without recursion or an explicit stack.
+void free_nodes(node *current) {
+    while (current) {
+        if (current->left) {
+            node *left = current->left;
+            current->left = left->right;
+            left->right = current;
+            current = left;
+        } else {
+            node *next = current->right;
+            free(current);
+            current = next;
+        }
+    }
+}
@@ -0,0 +1,261 @@
+#include "bptree.h"
+
+BPTree *bptree_create(int m, int (*compare_func)(const void *, const void *), void (*free_key)(void *), void (*free_data)(void *));
+void bptree_free(BPTree *tree);
+bool bptree_insert(BPTree *tree, void *key, void *data);
+void **bptree_search(BPTree *tree, const void *key);
+int bptree_range_scan(BPTree *tree, const void *lo, const void *hi, bptree_visit callback, void *ctx);
+BPNode *bptree_first_leaf(BPTree *tree);
+BPNode *bpnode_create(BPTree *tree, bool is_leaf);
+void bpnode_destroy(BPTree *tree, BPNode *node);
+int bpnode_lower_bound(BPTree *tree, BPNode *node, const void *key, int *cmp);
+BPNode *bptree_find_leaf(BPTree *tree, const void *key);
+bool bpnode_reserve(BPTree *tree, int count, BPNode **spares);
+BPNode *bpnode_take(BPNode **spares, bool is_leaf);
+BPNode *bptree_insert_recursive(BPTree *tree, BPNode *current, void *key, void *data, int full_above, BPNode **spares, void **sep_up, bool *added);
+BPNode *bpleaf_split(BPNode *leaf, BPNode *right, void **sep_up);
+BPNode *bpinternal_split(BPNode *node, BPNode *right, void **sep_up);
+
+BPTree *bptree_create(int m, int (*compare_func)(const void *, const void *), void (*free_key)(void *), void (*free_data)(void *)) {
+    if (m < 3) {
+        printf("Warning: B+ tree order %d too small, using 3.\n", m);
+        m = 3;
+    }
+    BPTree *tree = (BPTree *)malloc(sizeof(BPTree));
+    if (!tree) {
+        perror("Failed to allocate memory for tree");
+        return NULL;
+    }
+    tree->size = 0;
+    tree->m = m;
+    tree->compare = compare_func;
+    tree->free_key = free_key;
+    tree->free_data = free_data;
+    tree->root = NULL;
+    return tree;
+}
+
+// keys[m] | children[m+1] (or data[m] in a leaf), one aligned allocation
+BPNode *bpnode_create(BPTree *tree, bool is_leaf) {
+    size_t bytes = sizeof(BPNode) + sizeof(void *) * (size_t)(2 * tree->m + 1);
+    bytes = (bytes + BPNODE_ALIGN - 1) & ~(size_t)(BPNODE_ALIGN - 1);
+    BPNode *node = (BPNode *)aligned_alloc(BPNODE_ALIGN, bytes);
+    if (!node) {
+        perror("Failed to allocate memory for BPNode");
+        return NULL;
+    }
+    memset(node, 0, bytes);
+    node->keys = node->slots;
+    node->children = (BPNode **)(node->slots + tree->m);
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+void bpnode_destroy(BPTree *tree, BPNode *node) {
+    if (!node) return;
+    if (node->is_leaf) { // separators alias leaf keys, so keys are freed here only
+        for (int i = 0; i < node->key_count; i++) {
+            if (tree->free_key && node->keys[i]) tree->free_key(node->keys[i]);
+            if (tree->free_data && node->data[i]) tree->free_data(node->data[i]);
+        }
+    } else {
+        for (int i = 0; i <= node->key_count; i++) {
+            bpnode_destroy(tree, node->children[i]);
+        }
+    }
+    free(node);
+}
+
+void bptree_free(BPTree *tree) {
+    if (!tree) return;
+    bpnode_destroy(tree, tree->root);
+    free(tree);
+}
+
+// First index whose key is >= key; *cmp is compare(key, keys[idx]), 1 past the end
+int bpnode_lower_bound(BPTree *tree, BPNode *node, const void *key, int *cmp) {
+    int lo = 0;
+    int hi = node->key_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (tree->compare(node->keys[mid], key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *cmp = lo < node->key_count ? tree->compare(key, node->keys[lo]) : 1;
+    return lo;
+}
+
+// Leaf whose range covers key; a separator equal to key sends us right
+BPNode *bptree_find_leaf(BPTree *tree, const void *key) {
+    BPNode *node = tree->root;
+    while (node && !node->is_leaf) {
+        int cmp;
+        int idx = bpnode_lower_bound(tree, node, key, &cmp);
+        node = node->children[idx + (cmp == 0)];
+    }
+    return node;
+}
+
+BPNode *bptree_first_leaf(BPTree *tree) {
+    BPNode *node = tree->root;
+    while (node && !node->is_leaf) {
+        node = node->children[0];
+    }
+    return node;
+}
+
+void **bptree_search(BPTree *tree, const void *key) {
+    BPNode *leaf = bptree_find_leaf(tree, key);
+    if (!leaf) return NULL;
+    int cmp;
+    int idx = bpnode_lower_bound(tree, leaf, key, &cmp);
+    return cmp == 0 ? &leaf->data[idx] : NULL;
+}
+
+// Creates the count nodes an insert's split cascade will use, chained through
+// next, before anything is changed. All or nothing: on failure none are kept.
+bool bpnode_reserve(BPTree *tree, int count, BPNode **spares) {
+    for (int i = 0; i < count; i++) {
+        BPNode *node = bpnode_create(tree, false);
+        if (!node) {
+            while (*spares) {
+                BPNode *next = (*spares)->next;
+                free(*spares);
+                *spares = next;
+            }
+            return false;
+        }
+        node->next = *spares;
+        *spares = node;
+    }
+    return true;
+}
+
+BPNode *bpnode_take(BPNode **spares, bool is_leaf) {
+    BPNode *node = *spares;
+    *spares = node->next;
+    node->next = NULL;
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+// leaf holds m keys: the upper half moves to the empty right sibling whose first key goes up
+BPNode *bpleaf_split(BPNode *leaf, BPNode *right, void **sep_up) {
+    int mid = leaf->key_count / 2;
+    right->key_count = leaf->key_count - mid;
+    memcpy(right->keys, leaf->keys + mid, sizeof(void *) * right->key_count);
+    memcpy(right->data, leaf->data + mid, sizeof(void *) * right->key_count);
+    leaf->key_count = mid;
+    right->next = leaf->next;
+    right->prev = leaf;
+    if (leaf->next) leaf->next->prev = right;
+    leaf->next = right;
+    *sep_up = right->keys[0];
+    return right;
+}
+
+// internal node holds m keys: the middle separator moves up, the keys after it move right
+BPNode *bpinternal_split(BPNode *node, BPNode *right, void **sep_up) {
+    int mid = node->key_count / 2;
+    *sep_up = node->keys[mid];
+    right->key_count = node->key_count - mid - 1;
+    memcpy(right->keys, node->keys + mid + 1, sizeof(void *) * right->key_count);
+    memcpy(right->children, node->children + mid + 1, sizeof(BPNode *) * (right->key_count + 1));
+    node->key_count = mid;
+    return right;
+}
+
+// full_above counts the full nodes directly above current, plus the new root
+// if they reach the top: the nodes a split of current would cascade into.
+// They are all reserved at the leaf, so a NULL return means no split, and a
+// failed reservation returns before the leaf is touched.
+BPNode *bptree_insert_recursive(BPTree *tree, BPNode *current, void *key, void *data, int full_above, BPNode **spares, void **sep_up, bool *added) {
+    int cmp;
+    int idx = bpnode_lower_bound(tree, current, key, &cmp);
+    if (current->is_leaf) {
+        if (cmp == 0) { // existing key: replace the payload, the stored key stays
+            if (tree->free_data && current->data[idx] && current->data[idx] != data) {
+                tree->free_data(current->data[idx]);
+            }
+            current->data[idx] = data;
+            return NULL;
+        }
+        if (current->key_count == tree->m - 1 && !bpnode_reserve(tree, full_above + 1, spares)) return NULL;
+        int tail = current->key_count - idx;
+        memmove(current->keys + idx + 1, current->keys + idx, sizeof(void *) * tail);
+        memmove(current->data + idx + 1, current->data + idx, sizeof(void *) * tail);
+        current->keys[idx] = key;
+        current->data[idx] = data;
+        current->key_count++;
+        *added = true;
+        if (current->key_count < tree->m) return NULL;
+        return bpleaf_split(current, bpnode_take(spares, true), sep_up);
+    }
+    int child_idx = idx + (cmp == 0);
+    int full = current->key_count == tree->m - 1 ? full_above + 1 : 0;
+    void *sep;
+    BPNode *right = bptree_insert_recursive(tree, current->children[child_idx], key, data, full, spares, &sep, added);
+    if (!right) return NULL; // absorbed below
+    int tail = current->key_count - child_idx;
+    memmove(current->keys + child_idx + 1, current->keys + child_idx, sizeof(void *) * tail);
+    memmove(current->children + child_idx + 2, current->children + child_idx + 1, sizeof(BPNode *) * tail);
+    current->keys[child_idx] = sep;
+    current->children[child_idx + 1] = right;
+    current->key_count++;
+    if (current->key_count < tree->m) return NULL;
+    return bpinternal_split(current, bpnode_take(spares, false), sep_up);
+}
+
+// Returns true if key was added. On an existing key the payload is replaced
+// (the old one freed through free_data) and the caller keeps ownership of key.
+// Allocation failure also returns false, with the tree unchanged.
+bool bptree_insert(BPTree *tree, void *key, void *data) {
+    if (!tree->root) {
+        tree->root = bpnode_create(tree, true);
+        if (!tree->root) return false;
+    }
+    void *sep;
+    bool added = false;
+    BPNode *spares = NULL;
+    BPNode *right = bptree_insert_recursive(tree, tree->root, key, data, 1, &spares, &sep, &added);
+    if (right) { // root split
+        BPNode *new_root = bpnode_take(&spares, false);
+        new_root->keys[0] = sep;
+        new_root->children[0] = tree->root;
+        new_root->children[1] = right;
+        new_root->key_count = 1;
+        tree->root = new_root;
+    }
+    if (added) tree->size++;
+    return added;
+}
+
+// Visits every entry with lo <= key <= hi in order (NULL bound = open end) by
+// descending once and then following the leaf chain. Returns the number visited.
+int bptree_range_scan(BPTree *tree, const void *lo, const void *hi, bptree_visit callback, void *ctx) {
+    BPNode *leaf;
+    int i = 0;
+    if (lo) {
+        int cmp;
+        leaf = bptree_find_leaf(tree, lo);
+        if (leaf) i = bpnode_lower_bound(tree, leaf, lo, &cmp);
+    } else {
+        leaf = bptree_first_leaf(tree);
+    }
+    int visited = 0;
+    for (; leaf; leaf = leaf->next, i = 0) {
+        if (leaf->next) { // header and first keys of the sibling while this leaf streams
+            __builtin_prefetch(leaf->next);
+            __builtin_prefetch((const char *)leaf->next + BPNODE_ALIGN);
+        }
+        for (; i < leaf->key_count; i++) {
+            if (hi && tree->compare(leaf->keys[i], hi) > 0) return visited;
+            visited++;
+            if (callback && !callback(leaf->keys[i], leaf->data[i], ctx)) return visited;
+        }
+    }
+    return visited;
+}
@@ -0,0 +1,49 @@
+#ifndef BPTREE_H
+#define BPTREE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+// B+ tree over generic keys. Payloads live only in the leaves, internal nodes
+// hold separator keys and children (no data array, so more of a node is
+// fanout), and leaves are chained both ways so a range scan walks them
+// sequentially. A separator is the first key of the subtree to its right and
+// points at the same key object as that leaf entry; only leaves own keys.
+
+#define BPNODE_ALIGN 64
+
+typedef struct BPNode_struct {
+    int key_count;
+    bool is_leaf;
+    struct BPNode_struct *next; // leaves only: right sibling
+    struct BPNode_struct *prev; // leaves only: left sibling
+    void **keys;                // capacity m (one overflow slot for splits)
+    union {
+        struct BPNode_struct **children; // internal: capacity m+1
+        void **data;                     // leaf: capacity m
+    };
+    void *slots[];
+} BPNode;
+
+typedef struct BPTree_struct {
+    int size;
+    int m; // max children per internal node, max keys per leaf is m-1
+    int (*compare)(const void *, const void *);
+    void (*free_key)(void *);
+    void (*free_data)(void *);
+    BPNode *root;
+} BPTree;
+
+// callback for bptree_range_scan; return false to stop the scan
+typedef bool (*bptree_visit)(const void *key, void *data, void *ctx);
+
+BPTree *bptree_create(int m, int (*compare_func)(const void *, const void *), void (*free_key)(void *), void (*free_data)(void *));
+void bptree_free(BPTree *tree);
+bool bptree_insert(BPTree *tree, void *key, void *data);
+void **bptree_search(BPTree *tree, const void *key);
+int bptree_range_scan(BPTree *tree, const void *lo, const void *hi, bptree_visit callback, void *ctx);
+BPNode *bptree_first_leaf(BPTree *tree);
+
+#endif
@@ -5,13 +5,22 @@
 #include <math.h>
 #include <time.h>
 
+#define BNODE_ALIGN 64 // cache line
+#define BNODE_LINEAR_MAX 8 // nodes with more keys are searched by branchless binary search
+#define BTREE_BATCH_INFLIGHT 8 // lookups interleaved by btree_search_batch
+#define BTREE_PREFETCH_LINES 8 // cap on cache lines prefetched per node (header + keys)
+
+// One allocation per node: the arrays below point into slots[], laid out as
+// keys[m-1] | children[m] | data[m-1] so a descent reads keys and children
+// from contiguous memory and only touches data on a hit.
 typedef struct BNode_struct {
-    void **keys;
-    void **data;
-    struct BNode_struct **children;
     int key_count;
     bool is_leaf;
     struct BNode_struct *parent;
+    void **keys;
+    struct BNode_struct **children;
+    void **data;
+    void *slots[];
 } BNode;
 
 typedef struct BTree_struct {
@@ -23,6 +32,7 @@ typedef struct BTree_struct {
     void (*free_key)(void *);
     BNode *root;
     int m;
+    int min_keys; // a non-root node below this many keys is rebalanced on delete
 } BTree;
 
 BTree *create_tree(int m, int (*compare_func)(const void *, const void *), void (*print_key)(const void *),void (*print_data)(const void *) , void (*free_data)(void *) , void (*free_key)(void *));
@@ -33,10 +43,23 @@ bool is_empty(BTree *tree);
 void insert(BTree *tree, void *data, void *key);
 void** search(BTree *tree, const void *key);
 BNode *recursive_search(BTree *tree, BNode *node, const void *key);
+void btree_search_batch(BTree *tree, const void **keys, size_t n, void ***out);
+void prefetch_node(BTree *tree, BNode *node);
 BNode *insert_recursive(BTree *tree, BNode *current, void *key, void *data, void **key_up, void **data_up);
 void insert_key_data(BNode *node, void *key, void *data, BNode *child, int pos);
 int find_child_index(BTree *tree, BNode *current, void *key);
-BNode *split_node(BTree *tree, BNode *old_node, void *new_key, void *new_data, BNode *new_child, void **median_key, void **median_data);
+int node_lower_bound(BTree *tree, BNode *node, const void *key, int *cmp);
+BNode *split_node(BTree *tree, BNode *old_node, int insert_idx, void *new_key, void *new_data, BNode *new_child, void **median_key, void **median_data);
 void realign_children(BNode *node, int pos, BNode *child_node);
+bool btree_bulk_load(BTree *tree, void **keys, void **data, int n, double fill_factor);
+int bulk_node_count(int entries, int target, int min_keys, int max_keys);
+void bulk_discard(BNode *node);
+bool btree_delete(BTree *tree, const void *key);
+void btree_set_min_fill(BTree *tree, int min_keys);
+void remove_key_data(BNode *node, int pos);
+void borrow_from_left(BNode *parent, int idx);
+void borrow_from_right(BNode *parent, int idx);
+void merge_children(BNode *parent, int idx);
+void fix_underflow(BTree *tree, BNode *node);
 void display(BTree *tree_obj);
 void display_tree_recursive(BTree *tree, BNode *node, const char *prefix, int depth);
\ No newline at end of file
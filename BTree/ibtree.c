@@ -0,0 +1,270 @@
+#include "ibtree.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IBTREE_X86 1
+#endif
+
+IBTree *ibtree_create(int m, void (*free_data)(void *));
+void ibtree_free(IBTree *tree);
+bool ibtree_insert(IBTree *tree, int64_t key, void *data);
+void **ibtree_search(IBTree *tree, int64_t key);
+const char *ibtree_simd_level(void);
+int ibtree_rank(const IBNode *node, int64_t key);
+IBNode *ibnode_create(IBTree *tree, bool is_leaf);
+void ibnode_destroy(IBTree *tree, IBNode *node);
+bool ibnode_reserve(IBTree *tree, int count, IBNode **spares);
+IBNode *ibnode_take(IBNode **spares, bool is_leaf);
+IBNode *ibtree_insert_recursive(IBTree *tree, IBNode *current, int64_t key, void *data, int full_above, IBNode **spares, int64_t *key_up, void **data_up, bool *added);
+IBNode *ibtree_split(IBNode *node, IBNode *right, int64_t *key_up, void **data_up);
+
+// rank kernels: number of keys[0..n) strictly below key, n a multiple of IBTREE_LANES
+static int rank_scalar(const int64_t *keys, int n, int64_t key) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        count += keys[i] < key;
+    }
+    return count;
+}
+
+#ifdef IBTREE_X86
+__attribute__((target("sse4.2")))
+static int rank_sse42(const int64_t *keys, int n, int64_t key) {
+    __m128i probe = _mm_set1_epi64x(key);
+    int count = 0;
+    for (int i = 0; i < n; i += 2) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(keys + i));
+        __m128i below = _mm_cmpgt_epi64(probe, block);
+        count += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(below)));
+    }
+    return count;
+}
+
+__attribute__((target("avx2")))
+static int rank_avx2(const int64_t *keys, int n, int64_t key) {
+    __m256i probe = _mm256_set1_epi64x(key);
+    int count = 0;
+    for (int i = 0; i < n; i += 4) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(keys + i));
+        __m256i below = _mm256_cmpgt_epi64(probe, block);
+        count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(below)));
+    }
+    return count;
+}
+#endif
+
+static int (*rank_impl)(const int64_t *, int, int64_t) = NULL;
+static const char *rank_level = "scalar";
+
+static void rank_dispatch(void) {
+    if (rank_impl) return;
+    rank_impl = rank_scalar;
+#ifdef IBTREE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        rank_impl = rank_avx2;
+        rank_level = "avx2";
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        rank_impl = rank_sse42;
+        rank_level = "sse4.2";
+    }
+#endif
+}
+
+const char *ibtree_simd_level(void) {
+    rank_dispatch();
+    return rank_level;
+}
+
+int ibtree_rank(const IBNode *node, int64_t key) {
+    int n = (node->key_count + IBTREE_LANES - 1) & ~(IBTREE_LANES - 1);
+    return rank_impl(node->keys, n, key);
+}
+
+IBTree *ibtree_create(int m, void (*free_data)(void *)) {
+    if (m < 3) {
+        printf("Warning: B-tree order %d too small, using 3.\n", m);
+        m = 3;
+    }
+    IBTree *tree = (IBTree *)malloc(sizeof(IBTree));
+    if (!tree) {
+        perror("Failed to allocate memory for tree");
+        return NULL;
+    }
+    rank_dispatch();
+    tree->size = 0;
+    tree->m = m;
+    tree->key_cap = (m + IBTREE_LANES - 1) & ~(IBTREE_LANES - 1);
+    tree->free_data = free_data;
+    tree->root = NULL;
+    return tree;
+}
+
+IBNode *ibnode_create(IBTree *tree, bool is_leaf) {
+    size_t bytes = sizeof(IBNode) + sizeof(int64_t) * tree->key_cap + sizeof(void *) * (2 * tree->m + 1);
+    bytes = (bytes + 63) & ~(size_t)63;
+    IBNode *node = (IBNode *)aligned_alloc(64, bytes);
+    if (!node) {
+        perror("Failed to allocate memory for IBNode");
+        return NULL;
+    }
+    memset(node, 0, bytes);
+    node->keys = node->slots;
+    node->children = (IBNode **)(node->slots + tree->key_cap);
+    node->data = (void **)(node->children + tree->m + 1);
+    for (int i = 0; i < tree->key_cap; i++) {
+        node->keys[i] = IBTREE_PAD;
+    }
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+void ibnode_destroy(IBTree *tree, IBNode *node) {
+    if (!node) return;
+    if (tree->free_data) {
+        for (int i = 0; i < node->key_count; i++) {
+            if (node->data[i]) tree->free_data(node->data[i]);
+        }
+    }
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->key_count; i++) {
+            ibnode_destroy(tree, node->children[i]);
+        }
+    }
+    free(node);
+}
+
+void ibtree_free(IBTree *tree) {
+    if (!tree) return;
+    ibnode_destroy(tree, tree->root);
+    free(tree);
+}
+
+void **ibtree_search(IBTree *tree, int64_t key) {
+    IBNode *node = tree->root;
+    while (node) {
+        int r = rank_impl(node->keys, (node->key_count + IBTREE_LANES - 1) & ~(IBTREE_LANES - 1), key);
+        if (r < node->key_count && node->keys[r] == key) {
+            return &node->data[r];
+        }
+        if (node->is_leaf) return NULL;
+        node = node->children[r];
+    }
+    return NULL;
+}
+
+// Creates the count nodes an insert's split cascade will use, chained through
+// parent, before anything is changed. All or nothing: on failure none are kept.
+bool ibnode_reserve(IBTree *tree, int count, IBNode **spares) {
+    for (int i = 0; i < count; i++) {
+        IBNode *node = ibnode_create(tree, false);
+        if (!node) {
+            while (*spares) {
+                IBNode *next = (*spares)->parent;
+                free(*spares);
+                *spares = next;
+            }
+            return false;
+        }
+        node->parent = *spares;
+        *spares = node;
+    }
+    return true;
+}
+
+IBNode *ibnode_take(IBNode **spares, bool is_leaf) {
+    IBNode *node = *spares;
+    *spares = node->parent;
+    node->parent = NULL;
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+// node holds m keys after an overflowing insert: keep the lower half, move the upper half to the empty right
+IBNode *ibtree_split(IBNode *node, IBNode *right, int64_t *key_up, void **data_up) {
+    int mid = node->key_count / 2;
+    *key_up = node->keys[mid];
+    *data_up = node->data[mid];
+    right->key_count = node->key_count - mid - 1;
+    right->parent = node->parent;
+    memcpy(right->keys, node->keys + mid + 1, sizeof(int64_t) * right->key_count);
+    memcpy(right->data, node->data + mid + 1, sizeof(void *) * right->key_count);
+    if (!node->is_leaf) {
+        memcpy(right->children, node->children + mid + 1, sizeof(IBNode *) * (right->key_count + 1));
+        for (int i = 0; i <= right->key_count; i++) {
+            right->children[i]->parent = right;
+        }
+    }
+    for (int i = mid; i < node->key_count; i++) { // restore padding for the rank kernels
+        node->keys[i] = IBTREE_PAD;
+        node->data[i] = NULL;
+        node->children[i + 1] = NULL;
+    }
+    node->key_count = mid;
+    return right;
+}
+
+// full_above counts the full nodes directly above current, plus the new root
+// if they reach the top: the nodes a split of current would cascade into.
+// They are all reserved at the leaf, so a NULL return means no split, and a
+// failed reservation returns before the leaf is touched.
+IBNode *ibtree_insert_recursive(IBTree *tree, IBNode *current, int64_t key, void *data, int full_above, IBNode **spares, int64_t *key_up, void **data_up, bool *added) {
+    int r = ibtree_rank(current, key);
+    if (r < current->key_count && current->keys[r] == key) {
+        current->data[r] = data; // existing key: replace payload
+        return NULL;
+    }
+    IBNode *new_child = NULL;
+    if (!current->is_leaf) {
+        int64_t mid_key;
+        void *mid_data;
+        int full = current->key_count == tree->m - 1 ? full_above + 1 : 0;
+        new_child = ibtree_insert_recursive(tree, current->children[r], key, data, full, spares, &mid_key, &mid_data, added);
+        if (!new_child) return NULL; // absorbed below
+        new_child->parent = current;
+        key = mid_key; // the child's median lands at r, its new right half at r+1
+        data = mid_data;
+    } else {
+        if (current->key_count == tree->m - 1 && !ibnode_reserve(tree, full_above + 1, spares)) return NULL;
+        *added = true;
+    }
+    int tail = current->key_count - r;
+    memmove(current->keys + r + 1, current->keys + r, sizeof(int64_t) * tail);
+    memmove(current->data + r + 1, current->data + r, sizeof(void *) * tail);
+    current->keys[r] = key;
+    current->data[r] = data;
+    if (new_child) {
+        memmove(current->children + r + 2, current->children + r + 1, sizeof(IBNode *) * tail);
+        current->children[r + 1] = new_child;
+    }
+    current->key_count++;
+    if (current->key_count < tree->m) return NULL;
+    return ibtree_split(current, ibnode_take(spares, current->is_leaf), key_up, data_up);
+}
+
+// Returns true if key was added; an existing key gets its payload replaced.
+// Allocation failure also returns false, with the tree unchanged.
+bool ibtree_insert(IBTree *tree, int64_t key, void *data) {
+    if (!tree->root) {
+        tree->root = ibnode_create(tree, true);
+        if (!tree->root) return false;
+    }
+    int64_t mid_key;
+    void *mid_data;
+    bool added = false;
+    IBNode *spares = NULL;
+    IBNode *split = ibtree_insert_recursive(tree, tree->root, key, data, 1, &spares, &mid_key, &mid_data, &added);
+    if (split) { // root split
+        IBNode *new_root = ibnode_take(&spares, false);
+        new_root->keys[0] = mid_key;
+        new_root->data[0] = mid_data;
+        new_root->key_count = 1;
+        new_root->children[0] = tree->root;
+        new_root->children[1] = split;
+        tree->root->parent = new_root;
+        split->parent = new_root;
+        tree->root = new_root;
+    }
+    if (added) tree->size++;
+    return added;
+}
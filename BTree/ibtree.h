@@ -0,0 +1,43 @@
+#ifndef IBTREE_H
+#define IBTREE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Integer-key B-tree. Keys are int64_t stored inline (32-bit keys widen
+// losslessly) and every node search is a single rank query: count the keys
+// smaller than the probe, done 4 (AVX2) or 2 (SSE4.2) keys per compare.
+// Unused key slots hold IBTREE_PAD so the vector loops never need a tail.
+
+#define IBTREE_PAD INT64_MAX
+#define IBTREE_LANES 4 // key arrays are padded to a multiple of this
+
+typedef struct IBNode_struct {
+    int key_count;
+    bool is_leaf;
+    struct IBNode_struct *parent;
+    int64_t *keys;                    // capacity m (one overflow slot for splits)
+    struct IBNode_struct **children;  // capacity m+1
+    void **data;                      // capacity m
+    int64_t slots[];
+} IBNode;
+
+typedef struct IBTree_struct {
+    int size;
+    int m;          // max children per node
+    int key_cap;    // m rounded up to IBTREE_LANES
+    void (*free_data)(void *);
+    IBNode *root;
+} IBTree;
+
+IBTree *ibtree_create(int m, void (*free_data)(void *));
+void ibtree_free(IBTree *tree);
+bool ibtree_insert(IBTree *tree, int64_t key, void *data);
+void **ibtree_search(IBTree *tree, int64_t key);
+const char *ibtree_simd_level(void);
+int ibtree_rank(const IBNode *node, int64_t key);
+
+#endif
@@ -1,4 +1,6 @@
 #include "header.h"
+#include "ibtree.h"
+#include "bptree.h"
 #include <time.h>
 
 // Comparison function for integers
@@ -78,6 +80,14 @@ void test_b_tree_random_big(int min_degree, int num_elements, int key_range) {
         }
     }
     
+    printf("\n=== Testing Delete on B-Tree (t=%d) ===\n", min_degree);
+    int deleted = 0;
+    for (int i = 0; i < num_elements; i += 2) {
+        deleted += btree_delete(tree, &inserted_keys[i]);
+    }
+    printf("Deleted %d keys (every other insert)\n", deleted);
+    display(tree);
+
     printf("\nFinal Tree size: %d\n", tree->size);
     
     free_tree(tree); // Assume free_tree works for BTree
@@ -85,7 +95,185 @@ void test_b_tree_random_big(int min_degree, int num_elements, int key_range) {
     printf("B-Tree (t=%d) test freed successfully.\n\n", min_degree);
 }
 
-int main() {
+void test_int_btree_simd(int m, int num_elements) {
+    printf("=== Testing integer-key B-Tree (m=%d, %s node search) ===\n", m, ibtree_simd_level());
+
+    IBTree *itree = ibtree_create(m, NULL);
+    BTree *tree = create_tree(m, compare_int, print_int, print_int, NULL, NULL);
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand();
+        ibtree_insert(itree, keys[i], &keys[i]);
+        insert(tree, &keys[i], &keys[i]);
+    }
+
+    clock_t start = clock();
+    int found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        found += ibtree_search(itree, keys[i]) != NULL;
+    }
+    double simd_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    int generic_found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        generic_found += search(tree, &keys[i]) != NULL;
+    }
+    double generic_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Found %d/%d keys: integer tree %.2f ms, generic tree %.2f ms (%d found)\n\n",
+           found, num_elements, simd_ms, generic_ms, generic_found);
+    ibtree_free(itree);
+    free_tree(tree);
+    free(keys);
+}
+
+bool sum_int(const void *key, void *data, void *ctx) {
+    (void)data;
+    *(long long *)ctx += *(const int *)key;
+    return true;
+}
+
+void test_bptree_range(int m, int num_elements) {
+    printf("=== Testing B+ tree range scan (m=%d) ===\n", m);
+
+    BPTree *tree = bptree_create(m, compare_int, NULL, NULL);
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand() % (num_elements * 4);
+        bptree_insert(tree, &keys[i], &keys[i]);
+    }
+
+    int lo = num_elements, hi = num_elements * 2;
+    long long sum = 0;
+    clock_t start = clock();
+    int in_range = bptree_range_scan(tree, &lo, &hi, sum_int, &sum);
+    double range_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    int total = bptree_range_scan(tree, NULL, NULL, NULL, NULL);
+    double full_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%d distinct keys, %d in [%d, %d] (sum %lld) in %.2f ms, full scan of %d in %.2f ms\n\n",
+           tree->size, in_range, lo, hi, sum, range_ms, total, full_ms);
+    bptree_free(tree);
+    free(keys);
+}
+
+void bench_btree(int m, int num_elements) {
+    BTree *tree = create_tree(m, compare_int, print_int, print_int, NULL, NULL);
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand();
+    }
+
+    clock_t start = clock();
+    for (int i = 0; i < num_elements; i++) {
+        insert(tree, &keys[i], &keys[i]);
+    }
+    double insert_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    int found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        found += search(tree, &keys[i]) != NULL;
+    }
+    double search_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    const void **probes = (const void **)malloc(sizeof(void *) * num_elements);
+    void ***results = (void ***)malloc(sizeof(void **) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        probes[i] = &keys[i];
+    }
+    start = clock();
+    btree_search_batch(tree, probes, num_elements, results);
+    double batch_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    int batch_found = 0;
+    for (int i = 0; i < num_elements; i++) {
+        batch_found += results[i] != NULL;
+    }
+
+    printf("m=%-4d insert %8.2f ms  search %8.2f ms  batch %8.2f ms  (%d/%d found, batch %d)\n",
+           m, insert_ms, search_ms, batch_ms, found, num_elements, batch_found);
+    free_tree(tree);
+    free(probes);
+    free(results);
+    free(keys);
+}
+
+// Delete/insert churn on a full tree, with the split minimum and with lazy fill
+void bench_churn(int m, int num_elements) {
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = rand();
+    }
+    for (int lazy = 0; lazy < 2; lazy++) {
+        BTree *tree = create_tree(m, compare_int, print_int, print_int, NULL, NULL);
+        if (lazy) btree_set_min_fill(tree, 1);
+        for (int i = 0; i < num_elements; i++) {
+            insert(tree, &keys[i], &keys[i]);
+        }
+        clock_t start = clock();
+        for (int round = 0; round < 4; round++) {
+            for (int i = round; i < num_elements; i += 4) {
+                btree_delete(tree, &keys[i]);
+            }
+            for (int i = round; i < num_elements; i += 4) {
+                insert(tree, &keys[i], &keys[i]);
+            }
+        }
+        double churn_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+        printf("m=%-4d churn %s (min_keys %d) %8.2f ms, size %d\n", m, lazy ? "lazy  " : "strict", tree->min_keys, churn_ms, tree->size);
+        free_tree(tree);
+    }
+    free(keys);
+}
+
+// Sorted load: insert loop against btree_bulk_load at 90% fill
+void bench_bulk_load(int m, int num_elements) {
+    int *keys = (int*)malloc(sizeof(int) * num_elements);
+    void **ptrs = (void **)malloc(sizeof(void *) * num_elements);
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i;
+        ptrs[i] = &keys[i];
+    }
+    BTree *inserted = create_tree(m, compare_int, print_int, print_int, NULL, NULL);
+    clock_t start = clock();
+    for (int i = 0; i < num_elements; i++) {
+        insert(inserted, &keys[i], &keys[i]);
+    }
+    double insert_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    BTree *loaded = create_tree(m, compare_int, print_int, print_int, NULL, NULL);
+    start = clock();
+    btree_bulk_load(loaded, ptrs, ptrs, num_elements, 0.9);
+    double bulk_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("m=%-4d sorted load: insert %8.2f ms, bulk %8.2f ms (size %d)\n", m, insert_ms, bulk_ms, loaded->size);
+    free_tree(inserted);
+    free_tree(loaded);
+    free(ptrs);
+    free(keys);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) { // ./gen_BTree bench [elements]
+        int num_elements = argc > 2 ? atoi(argv[2]) : 1000000;
+        int fanouts[] = {4, 16, 64, 256};
+        srand(42);
+        printf("B-Tree benchmark, %d random int keys\n", num_elements);
+        for (int i = 0; i < 4; i++) {
+            bench_btree(fanouts[i], num_elements);
+        }
+        for (int i = 0; i < 4; i++) {
+            bench_churn(fanouts[i], num_elements);
+        }
+        for (int i = 0; i < 4; i++) {
+            bench_bulk_load(fanouts[i], num_elements);
+        }
+        return 0;
+    }
+
     // Set a constant minimum degree (t). Common values are 2, 3, or 4.
     const int T_SMALL = 4;   // t=2 is a 2-3-4 tree (max 3 keys)
     const int T_MEDIUM = 6;  // t=4 (max 7 keys)
@@ -103,6 +291,10 @@ int main() {
     // Test a larger, wider B-Tree
     test_b_tree_random_big(T_MEDIUM, NUM_RECORDS, KEY_RANGE);
     
+    test_int_btree_simd(64, 100000);
+
+    test_bptree_range(64, 100000);
+
     printf("All B-Tree tests completed!\n");
     return 0;
 }
\ No newline at end of file
@@ -8,11 +8,24 @@ bool is_empty(BTree *tree);
 void insert(BTree *tree, void *data, void *key);
 void** search(BTree *tree, const void *key);
 BNode *recursive_search(BTree *tree, BNode *node, const void *key);
+void btree_search_batch(BTree *tree, const void **keys, size_t n, void ***out);
+void prefetch_node(BTree *tree, BNode *node);
 BNode *insert_recursive(BTree *tree, BNode *current, void *key, void *data, void **key_up, void **data_up);
 void insert_key_data(BNode *node, void *key, void *data, BNode *child, int pos);
 int find_child_index(BTree *tree, BNode *current, void *key);
-BNode *split_node(BTree *tree, BNode *old_node, void *new_key, void *new_data, BNode *new_child, void **median_key, void **median_data);
+int node_lower_bound(BTree *tree, BNode *node, const void *key, int *cmp);
+BNode *split_node(BTree *tree, BNode *old_node, int insert_idx, void *new_key, void *new_data, BNode *new_child, void **median_key, void **median_data);
 void realign_children(BNode *node, int pos, BNode *child_node);
+bool btree_bulk_load(BTree *tree, void **keys, void **data, int n, double fill_factor);
+int bulk_node_count(int entries, int target, int min_keys, int max_keys);
+void bulk_discard(BNode *node);
+bool btree_delete(BTree *tree, const void *key);
+void btree_set_min_fill(BTree *tree, int min_keys);
+void remove_key_data(BNode *node, int pos);
+void borrow_from_left(BNode *parent, int idx);
+void borrow_from_right(BNode *parent, int idx);
+void merge_children(BNode *parent, int idx);
+void fix_underflow(BTree *tree, BNode *node);
 void display(BTree *tree_obj);
 void display_tree_recursive(BTree *tree, BNode *node, const char *prefix, int depth);
 
@@ -34,18 +47,22 @@ BTree *create_tree(int m, int (*compare_func)(const void *, const void *), void
     tree_obj->print_data = print_data;
     tree_obj->free_data = free_data;
     tree_obj->free_key = free_key;
+    tree_obj->min_keys = (m + 1) / 2 - 1; // what a split leaves in the smaller half
     return tree_obj;
 }
 
 BNode* node_create(bool is_leaf , int m) {
-    BNode *node = (BNode *)malloc(sizeof(BNode));
+    size_t bytes = sizeof(BNode) + sizeof(void *) * (size_t)(3 * m - 2);
+    bytes = (bytes + BNODE_ALIGN - 1) & ~(size_t)(BNODE_ALIGN - 1); // aligned_alloc wants a multiple
+    BNode *node = (BNode *)aligned_alloc(BNODE_ALIGN, bytes);
     if (!node) {
         perror("Failed to allocate memory for BNode");
         return NULL;
     }
-    node->keys = (void **)calloc(m-1, sizeof(void *));
-    node->data = (void **)calloc(m-1, sizeof(void *));
-    node->children = (BNode **)calloc(m, sizeof(BNode *));
+    memset(node, 0, bytes);
+    node->keys = node->slots;
+    node->children = (BNode **)(node->slots + (m - 1));
+    node->data = node->slots + (2 * m - 1);
     node->key_count = 0;
     node->parent = NULL;
     node->is_leaf = is_leaf;
@@ -67,9 +84,6 @@ void node_destroy(BNode *BNode , BTree *tree) {
             node_destroy(BNode->children[i], tree);
         }
     }
-    free(BNode->data);
-    free(BNode->keys);
-    free(BNode->children);
     free(BNode);
 }
 
@@ -86,29 +100,107 @@ void** search(BTree *tree, const void *key) {
     }
     BNode *result = recursive_search(tree, tree->root, key);
     if (!result) return NULL;
-    for (int i = 0; i < result->key_count; i++) {
-        if (tree->compare(key, result->keys[i]) == 0) {
-            return &(result->data[i]); 
-        }
-    }
-    return NULL;
+    int cmp;
+    int idx = node_lower_bound(tree, result, key, &cmp);
+    return &(result->data[idx]);
 }
 
 BNode *recursive_search(BTree *tree , BNode *node , const void *key) {
     if(!node) return NULL;
-    for (int i = 0; i < node->key_count; i++) {
-        if (tree->compare(key, node->keys[i]) == 0) {
-            return node;
+    int cmp;
+    int idx = node_lower_bound(tree, node, key, &cmp);
+    if (cmp == 0) return node;
+    if (node->is_leaf) return NULL; // reached leaf
+    return recursive_search(tree, node->children[idx], key);
+}
+
+// Pulls in the node header and the front of its keys[] without touching the
+// node itself, so the lookup that owns it can be parked until it arrives.
+void prefetch_node(BTree *tree, BNode *node) {
+    const char *line = (const char *)node;
+    const char *keys_end = (const char *)(node->slots + (tree->m - 1)); // address math only
+    for (int i = 0; i < BTREE_PREFETCH_LINES && line < keys_end; i++, line += BNODE_ALIGN) {
+        __builtin_prefetch(line);
+    }
+}
+
+// AMAC-style batch lookup: BTREE_BATCH_INFLIGHT independent state machines,
+// each parked on a prefetched node. A slot whose lookup finishes is refilled
+// from the input right away, so the pipeline stays full. out[i] gets the data
+// slot for keys[i] as search() would return it, or NULL.
+void btree_search_batch(BTree *tree, const void **keys, size_t n, void ***out) {
+    BNode *slot_node[BTREE_BATCH_INFLIGHT];
+    size_t slot_key[BTREE_BATCH_INFLIGHT];
+    size_t next = 0;
+    int active = 0;
+    if (!tree->root) {
+        for (size_t i = 0; i < n; i++) out[i] = NULL;
+        return;
+    }
+    for (int s = 0; s < BTREE_BATCH_INFLIGHT; s++) {
+        slot_node[s] = NULL;
+        if (next < n) {
+            slot_key[s] = next++;
+            slot_node[s] = tree->root;
+            active++;
         }
     }
-    if (node->is_leaf) return NULL; // reached leaf
-    int i;
-    for (i = 0; i < node->key_count; i++) {
-        if (tree->compare(key, node->keys[i]) < 0) {
-            return recursive_search(tree, node->children[i], key);
+    prefetch_node(tree, tree->root);
+    while (active > 0) {
+        for (int s = 0; s < BTREE_BATCH_INFLIGHT; s++) {
+            BNode *node = slot_node[s];
+            if (!node) continue;
+            int cmp;
+            int idx = node_lower_bound(tree, node, keys[slot_key[s]], &cmp);
+            if (cmp != 0 && !node->is_leaf) { // descend and yield to the next slot
+                BNode *child = node->children[idx];
+                prefetch_node(tree, child);
+                slot_node[s] = child;
+                continue;
+            }
+            out[slot_key[s]] = cmp == 0 ? &node->data[idx] : NULL;
+            if (next < n) {
+                slot_key[s] = next++;
+                slot_node[s] = tree->root;
+            } else {
+                slot_node[s] = NULL;
+                active--;
+            }
         }
     }
-    return recursive_search(tree, node->children[i], key);
+}
+
+// First index whose key is >= key, and compare(key, keys[idx]) in *cmp
+// (positive when idx == key_count). Small nodes scan linearly, larger ones
+// run a branchless binary search so the loop carries no unpredictable jumps.
+int node_lower_bound(BTree *tree, BNode *node, const void *key, int *cmp) {
+    int n = node->key_count;
+    void **keys = node->keys;
+    if (n <= BNODE_LINEAR_MAX) {
+        for (int i = 0; i < n; i++) {
+            int c = tree->compare(key, keys[i]);
+            if (c <= 0) {
+                *cmp = c;
+                return i;
+            }
+        }
+        *cmp = 1;
+        return n;
+    }
+    int base = 0;
+    while (n > 1) {
+        int half = n / 2;
+        base += (tree->compare(keys[base + half], key) < 0) * half;
+        n -= half;
+    }
+    int c = tree->compare(key, keys[base]);
+    if (c <= 0) {
+        *cmp = c;
+        return base;
+    }
+    base++; // keys[base-1] < key <= keys[base]
+    *cmp = base < node->key_count ? tree->compare(key, keys[base]) : 1;
+    return base;
 }
 
 void insert_key_data(BNode *node, void *key, void *data, BNode *child, int pos) {
@@ -130,25 +222,15 @@ void insert_key_data(BNode *node, void *key, void *data, BNode *child, int pos)
 }
 
 int find_child_index(BTree *tree,BNode *current,void *key) {
-    int i;
-    for (i = 0; i < current->key_count; i++) {
-        if (tree->compare(key, current->keys[i]) < 0) {
-            return i;
-        }
-    }
-    return i;
+    int cmp;
+    return node_lower_bound(tree, current, key, &cmp);
 }
 
-BNode *split_node(BTree *tree, BNode *old_node, void *new_key, void *new_data, BNode *new_child, void **median_key, void **median_data) {
+BNode *split_node(BTree *tree, BNode *old_node, int insert_idx, void *new_key, void *new_data, BNode *new_child, void **median_key, void **median_data) {
     // temp node container
     void **all_keys = (void **)malloc(tree->m * sizeof(void *));
     void **all_data = (void **)malloc(tree->m * sizeof(void *));
     BNode **all_children = (BNode **)malloc((tree->m+1) * sizeof(BNode *));
-    
-    int insert_idx = 0;
-    while (insert_idx < old_node->key_count && tree->compare(new_key, old_node->keys[insert_idx]) > 0) {
-        insert_idx++;
-    }
 
     for (int i = 0 , j=0; i < tree->m; i++) {
         if (i == insert_idx) {
@@ -224,25 +306,19 @@ BNode *insert_recursive(BTree *tree, BNode *current, void *key, void *data, void
     if (current == NULL) {
         return NULL;
     }
-    int pos;
+    int cmp;
+    int pos = node_lower_bound(tree , current , key , &cmp); // leaf slot or child to descend
     if(current->is_leaf) {
-        pos = 0;
-        for (int i = 0; i < current->key_count; i++) {
-            if (tree->compare(key, current->keys[i]) < 0) {
-                break;
-            }
-            pos++;
-        }   
         if(current->key_count < (tree->m - 1)) { // case 1 (not full node -> simple insert)
             insert_key_data(current , key , data , NULL , pos);
             return NULL; // no split
         } else {
-            BNode *new_node = split_node(tree , current , key , data , NULL , key_up , data_up);
+            BNode *new_node = split_node(tree , current , pos , key , data , NULL , key_up , data_up);
             return new_node; // case 2 (full node -> split)
         }
     }
 
-    int child_idx = find_child_index(tree , current , key);
+    int child_idx = pos;
     void *mid_key = NULL; // to pass up to parent
     void *mid_data = NULL; // to pass up to parent
     BNode *split_child = insert_recursive(tree , current->children[child_idx] , key , data , &mid_key , &mid_data);
@@ -251,18 +327,12 @@ BNode *insert_recursive(BTree *tree, BNode *current, void *key, void *data, void
     }
     split_child->parent = current;
     if(current->key_count < (tree->m-1) ) { // case 3 simple insert (space found)
-        pos = 0;
-        for (int i = 0; i < current->key_count; i++) {
-            if (tree->compare(key, current->keys[i]) < 0) {
-                break;
-            }
-            pos++;
-        } 
-        insert_key_data(current , mid_key , mid_data , split_child , pos);
-        realign_children(current , pos , split_child);
+        // the child's median sits right where we descended, its new sibling just after
+        insert_key_data(current , mid_key , mid_data , split_child , child_idx);
+        realign_children(current , child_idx , split_child);
         return NULL; // no split
     } else {
-        BNode *new_node =  split_node(tree , current , mid_key , mid_data, split_child , key_up , data_up); // case 4 (split current with split_child)
+        BNode *new_node =  split_node(tree , current , child_idx , mid_key , mid_data, split_child , key_up , data_up); // case 4 (split current with split_child)
         return new_node;
     }
 }
@@ -293,6 +363,278 @@ void insert(BTree *tree, void *data , void *key) {
     tree->size++;
 } 
 
+// How many nodes one level needs so that its entries, minus the k-1 that move
+// up as separators, spread evenly at about target keys per node without any
+// node leaving [min_keys, max_keys].
+int bulk_node_count(int entries, int target, int min_keys, int max_keys) {
+    int k = (entries + target) / (target + 1); // ceil((entries + 1) / (target + 1))
+    if (k < 1) k = 1;
+    while (k > 1 && (entries - k + 1) / k < min_keys) k--;
+    while ((entries - k + 1 + k - 1) / k > max_keys) k++; // ceil of the per-node share
+    return k;
+}
+
+// frees the nodes of a half-built level, payloads still belong to the caller
+void bulk_discard(BNode *node) {
+    if (!node) return;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->key_count; i++) {
+            bulk_discard(node->children[i]);
+        }
+    }
+    free(node);
+}
+
+// Builds the tree bottom-up from keys sorted by tree->compare (data may be
+// NULL). Leaves are filled left to right at fill_factor of capacity, the key
+// after each leaf becomes a separator, and the separators are packed the same
+// way into each level above until one node is left. No split ever runs.
+// Returns false, leaving the tree untouched, if it is not empty, the keys are
+// not sorted or memory runs out.
+bool btree_bulk_load(BTree *tree, void **keys, void **data, int n, double fill_factor) {
+    if (tree->root || n <= 0) return n == 0 && !tree->root;
+    for (int i = 1; i < n; i++) {
+        if (tree->compare(keys[i-1], keys[i]) > 0) return false;
+    }
+    int max_keys = tree->m - 1;
+    int min_keys = tree->min_keys < 1 ? 1 : tree->min_keys;
+    int target = (int)(fill_factor * max_keys);
+    if (target > max_keys) target = max_keys;
+    if (target < min_keys) target = min_keys;
+
+    int nodes = bulk_node_count(n, target, min_keys, max_keys);
+    void **level_keys = (void **)malloc(sizeof(void *) * nodes); // separators promoted from a level
+    void **level_data = (void **)malloc(sizeof(void *) * nodes);
+    BNode **level_nodes = (BNode **)malloc(sizeof(BNode *) * nodes);
+    if (!level_keys || !level_data || !level_nodes) {
+        perror("Failed to allocate memory for bulk load");
+        free(level_keys);
+        free(level_data);
+        free(level_nodes);
+        return false;
+    }
+
+    void **src_keys = keys;
+    void **src_data = data;
+    int entries = n;
+    BNode **children = NULL; // NULL while building leaves
+    bool ok = true;
+    while (true) {
+        nodes = bulk_node_count(entries, target, min_keys, max_keys);
+        int share = entries - (nodes - 1); // entries kept in nodes, the rest go up
+        int pos = 0; // next entry to place
+        int child = 0; // next child to attach
+        int built = 0;
+        for (int i = 0; i < nodes; i++) {
+            int count = share / nodes + (i < share % nodes);
+            BNode *node = node_create(children == NULL, tree->m);
+            if (!node) {
+                ok = false;
+                break;
+            }
+            for (int j = 0; j < count; j++, pos++) {
+                node->keys[j] = src_keys[pos];
+                node->data[j] = src_data ? src_data[pos] : NULL;
+            }
+            if (children) {
+                for (int j = 0; j <= count; j++, child++) {
+                    node->children[j] = children[child];
+                    children[child]->parent = node;
+                }
+            }
+            node->key_count = count;
+            level_nodes[built++] = node;
+            if (i < nodes - 1) { // the next entry separates this node from the next
+                level_keys[i] = src_keys[pos];
+                level_data[i] = src_data ? src_data[pos] : NULL;
+                pos++;
+            }
+        }
+        if (!ok) {
+            for (int i = 0; i < built; i++) bulk_discard(level_nodes[i]);
+            if (children) { // subtrees not yet adopted by this level
+                for (int j = child; j < entries + 1; j++) bulk_discard(children[j]);
+            }
+            break;
+        }
+        if (nodes == 1) {
+            tree->root = level_nodes[0];
+            break;
+        }
+        // promoted separators and the new nodes are the next level's input,
+        // compacted in place since a level never outgrows the one below it
+        src_keys = level_keys;
+        src_data = level_data;
+        entries = nodes - 1;
+        children = level_nodes;
+    }
+    free(level_keys);
+    free(level_data);
+    free(level_nodes);
+    if (!ok) {
+        perror("Failed to allocate memory for BNode");
+        return false;
+    }
+    tree->size = n;
+    return true;
+}
+
+// Lazy deletion: let nodes drain down to min_keys (at least 1) before they are
+// refilled or merged, so churn around the threshold stops bouncing between
+// merge and split. Values above the split minimum are clamped to it.
+void btree_set_min_fill(BTree *tree, int min_keys) {
+    int strict = (tree->m + 1) / 2 - 1;
+    if (min_keys > strict) min_keys = strict;
+    if (min_keys < 1) min_keys = 1;
+    tree->min_keys = min_keys;
+}
+
+// drop keys[pos]/data[pos] and, in an internal node, children[pos+1]
+void remove_key_data(BNode *node, int pos) {
+    for (int i = pos; i < node->key_count - 1; i++) {
+        node->keys[i] = node->keys[i+1];
+        node->data[i] = node->data[i+1];
+    }
+    if (!node->is_leaf) {
+        for (int i = pos + 1; i < node->key_count; i++) {
+            node->children[i] = node->children[i+1];
+        }
+        node->children[node->key_count] = NULL;
+    }
+    node->key_count--;
+    node->keys[node->key_count] = NULL;
+    node->data[node->key_count] = NULL;
+}
+
+// children[idx] takes the separator on its left, the left sibling's last key goes up
+void borrow_from_left(BNode *parent, int idx) {
+    BNode *node = parent->children[idx];
+    BNode *left = parent->children[idx-1];
+    for (int i = node->key_count; i > 0; i--) {
+        node->keys[i] = node->keys[i-1];
+        node->data[i] = node->data[i-1];
+    }
+    if (!node->is_leaf) {
+        for (int i = node->key_count + 1; i > 0; i--) {
+            node->children[i] = node->children[i-1];
+        }
+        node->children[0] = left->children[left->key_count];
+        node->children[0]->parent = node;
+        left->children[left->key_count] = NULL;
+    }
+    node->keys[0] = parent->keys[idx-1];
+    node->data[0] = parent->data[idx-1];
+    node->key_count++;
+    left->key_count--;
+    parent->keys[idx-1] = left->keys[left->key_count];
+    parent->data[idx-1] = left->data[left->key_count];
+    left->keys[left->key_count] = NULL;
+    left->data[left->key_count] = NULL;
+}
+
+// children[idx] takes the separator on its right, the right sibling's first key goes up
+void borrow_from_right(BNode *parent, int idx) {
+    BNode *node = parent->children[idx];
+    BNode *right = parent->children[idx+1];
+    node->keys[node->key_count] = parent->keys[idx];
+    node->data[node->key_count] = parent->data[idx];
+    if (!node->is_leaf) {
+        node->children[node->key_count + 1] = right->children[0];
+        right->children[0]->parent = node;
+        for (int i = 0; i < right->key_count; i++) {
+            right->children[i] = right->children[i+1];
+        }
+        right->children[right->key_count] = NULL;
+    }
+    node->key_count++;
+    parent->keys[idx] = right->keys[0];
+    parent->data[idx] = right->data[0];
+    for (int i = 0; i < right->key_count - 1; i++) {
+        right->keys[i] = right->keys[i+1];
+        right->data[i] = right->data[i+1];
+    }
+    right->key_count--;
+    right->keys[right->key_count] = NULL;
+    right->data[right->key_count] = NULL;
+}
+
+// fold separator idx and children[idx+1] into children[idx], freeing the right node
+void merge_children(BNode *parent, int idx) {
+    BNode *left = parent->children[idx];
+    BNode *right = parent->children[idx+1];
+    int base = left->key_count;
+    left->keys[base] = parent->keys[idx];
+    left->data[base] = parent->data[idx];
+    for (int i = 0; i < right->key_count; i++) {
+        left->keys[base + 1 + i] = right->keys[i];
+        left->data[base + 1 + i] = right->data[i];
+    }
+    if (!left->is_leaf) {
+        for (int i = 0; i <= right->key_count; i++) {
+            left->children[base + 1 + i] = right->children[i];
+            right->children[i]->parent = left;
+        }
+    }
+    left->key_count += 1 + right->key_count;
+    remove_key_data(parent, idx); // also drops children[idx+1]
+    free(right);
+}
+
+// Walk up from node while it is below min_keys: borrow from a sibling that can
+// spare a key, otherwise merge with one and retry at the parent. An emptied
+// root is collapsed onto its only child.
+void fix_underflow(BTree *tree, BNode *node) {
+    while (node != tree->root && node->key_count < tree->min_keys) {
+        BNode *parent = node->parent;
+        int idx = 0;
+        while (parent->children[idx] != node) idx++;
+        if (idx > 0 && parent->children[idx-1]->key_count > tree->min_keys) {
+            borrow_from_left(parent, idx);
+            return;
+        }
+        if (idx < parent->key_count && parent->children[idx+1]->key_count > tree->min_keys) {
+            borrow_from_right(parent, idx);
+            return;
+        }
+        merge_children(parent, idx > 0 ? idx - 1 : idx);
+        node = parent;
+    }
+    BNode *root = tree->root;
+    if (root->key_count == 0) {
+        tree->root = root->is_leaf ? NULL : root->children[0];
+        if (tree->root) tree->root->parent = NULL;
+        free(root);
+    }
+}
+
+// Removes one entry matching key, freeing its key and data through the tree's
+// free callbacks. Returns false when key is not present.
+bool btree_delete(BTree *tree, const void *key) {
+    BNode *node = tree->root;
+    int idx = 0;
+    while (node) {
+        int cmp;
+        idx = node_lower_bound(tree, node, key, &cmp);
+        if (cmp == 0) break;
+        node = node->is_leaf ? NULL : node->children[idx];
+    }
+    if (!node) return false;
+    if (tree->free_key && node->keys[idx]) tree->free_key(node->keys[idx]);
+    if (tree->free_data && node->data[idx]) tree->free_data(node->data[idx]);
+    if (!node->is_leaf) { // swap in the predecessor, then remove it from its leaf
+        BNode *leaf = node->children[idx];
+        while (!leaf->is_leaf) leaf = leaf->children[leaf->key_count];
+        node->keys[idx] = leaf->keys[leaf->key_count - 1];
+        node->data[idx] = leaf->data[leaf->key_count - 1];
+        node = leaf;
+        idx = leaf->key_count - 1;
+    }
+    remove_key_data(node, idx);
+    tree->size--;
+    fix_underflow(tree, node);
+    return true;
+}
+
 void display(BTree *tree_obj) {
     if (is_empty(tree_obj) || !tree_obj->root) {
         printf("Tree is empty.\n");
@@ -1,11 +1,15 @@
+#ifndef HEAP_H
+#define HEAP_H
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 
-#define LEFT(i) (2 * (i) + 1)
-#define RIGHT(i) (2 * (i) + 2)
-#define PARENT(i) (((i) - 1) / 2)
+// d-ary layout, d = 1 << shift: the children of i are the d contiguous
+// slots starting at DARY_CHILD(i)
+#define DARY_CHILD(i, shift) (((i) << (shift)) + 1)
+#define DARY_PARENT(i, shift) (((i) - 1) >> (shift))
 
 typedef struct elem_struct {
     void *data;       
@@ -15,8 +19,12 @@ typedef struct elem_struct {
 typedef struct heap_struct {
     int size;
     bool is_max; 
+    bool by_value; // elements live inline in values[] instead of data[]
+    int arity; // children per node: 2, 4, 8 or 16
+    int arity_shift; // log2(arity)
     int capacity;
     elem **data;
+    elem *values;
 } heap;
 
 void resize(heap **heap_obj , size_t new_cap);
@@ -26,13 +34,20 @@ void swap(heap *heap_obj , int index1 , int index2);
 int compare(heap *heap_obj, int index1, int index2);
 void increase_key(heap *heap_obj , int index);
 heap *build_heap(int capacity , const char *type);
+heap *build_value_heap(int capacity , const char *type);
 void build_my_heap(heap **heap_obj);
+bool set_arity(heap *heap_obj , int arity);
 void build_heap_from_array(heap *heap_obj , elem **elements , int num_elements);  
 void heapify_down(heap **heap_obj , int index);
 void heap_insert(heap **heap_obj , void *user_elem , long int key);
 elem *extract_peek(heap **heap_obj); 
+bool extract_peek_into(heap **heap_obj , elem *out);
+void value_sift_up(heap *heap_obj , int index);
+void value_sift_down(heap *heap_obj , int index , int n);
 elem **get_heap_sort(heap **heap_obj); 
 void heap_sort(heap **heap_obj);
 void print_queue(heap *heap_obj, void (*print_elem)(void *)); 
 void free_heap(heap *heap_obj);
-bool is_empty(heap *heap_obj);
\ No newline at end of file
+bool is_empty(heap *heap_obj);
+
+#endif
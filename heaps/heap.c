@@ -15,6 +15,10 @@ heap *build_heap(int capacity , const char *type) {
     }
     memset(heap_obj->data, 0, sizeof(elem *) * heap_obj->capacity);
     heap_obj->size = 0;
+    heap_obj->by_value = false;
+    heap_obj->values = NULL;
+    heap_obj->arity = 2;
+    heap_obj->arity_shift = 1;
     if (strcmp(type , "min") == 0) heap_obj->is_max = false;
     else if (strcmp(type , "max") == 0) heap_obj->is_max = true;
     else {
@@ -24,7 +28,32 @@ heap *build_heap(int capacity , const char *type) {
     return heap_obj;
 }
 
+heap *build_value_heap(int capacity , const char *type) {
+    heap *heap_obj = build_heap(capacity , type);
+    if (!heap_obj) return NULL;
+    free(heap_obj->data); // value mode never uses the pointer array
+    heap_obj->data = NULL;
+    heap_obj->values = (elem *)malloc(sizeof(elem) * heap_obj->capacity);
+    if (!heap_obj->values) {
+        perror("Failed to allocate heap array");
+        free(heap_obj);
+        return NULL;
+    }
+    heap_obj->by_value = true;
+    return heap_obj;
+}
+
 void resize(heap **heap_obj , size_t new_cap) {
+    if ((*heap_obj)->by_value) {
+        elem *new_values = (elem *)realloc((*heap_obj)->values, sizeof(elem) * new_cap);
+        if (new_values == NULL) {
+            perror("Failed to resize heap array");
+            return;
+        }
+        (*heap_obj)->values = new_values;
+        (*heap_obj)->capacity = new_cap;
+        return;
+    }
     elem **new_data = (elem **)realloc((*heap_obj)->data, sizeof(elem *) * new_cap);
     if (new_data == NULL) {
         perror("Failed to resize heap array");
@@ -47,6 +76,7 @@ void *get_peek(heap *heap_obj) {
         printf("Heap empty\n");
         return NULL;
     } 
+    if (heap_obj->by_value) return heap_obj->values[0].data;
     return heap_obj->data[0]->data;
 }
 
@@ -70,37 +100,90 @@ int compare(heap *heap_obj , int index1 , int index2) {
     }
 }
 
+// true when key1 belongs above key2
+static inline bool value_before(const heap *heap_obj , long int key1 , long int key2) {
+    return heap_obj->is_max ? key1 > key2 : key1 < key2;
+}
+
+// hole-based sifts: move the element once instead of swapping per level
+void value_sift_up(heap *heap_obj , int index) {
+    elem *v = heap_obj->values;
+    elem moving = v[index];
+    while (index > 0) {
+        int parent = DARY_PARENT(index, heap_obj->arity_shift);
+        if (!value_before(heap_obj, moving.key, v[parent].key)) break;
+        v[index] = v[parent];
+        index = parent;
+    }
+    v[index] = moving;
+}
+
+// Each level scans the d children in one pass; they sit next to each other,
+// so a wider node costs more compares but fewer levels (cache misses).
+void value_sift_down(heap *heap_obj , int index , int n) {
+    elem *v = heap_obj->values;
+    elem moving = v[index];
+    int shift = heap_obj->arity_shift;
+    int child;
+    while ((child = DARY_CHILD(index, shift)) < n) {
+        int end = child + heap_obj->arity < n ? child + heap_obj->arity : n;
+        int best = child;
+        for (int c = child + 1; c < end; c++) {
+            if (value_before(heap_obj, v[c].key, v[best].key)) best = c;
+        }
+        if (!value_before(heap_obj, v[best].key, moving.key)) break;
+        v[index] = v[best];
+        index = best;
+    }
+    v[index] = moving;
+}
+
 void heapify_down(heap **heap_obj , int index) {
     heap *h = *heap_obj;
-    int highest = index;
-    int left_ch = LEFT(index);
-    int right_ch = RIGHT(index);
+    elem **d = h->data;
+    elem *moving = d[index];
     int n = h->size;
-    if (left_ch < n && compare(h, left_ch, highest) > 0) {
-        highest = left_ch;
-    }
-    if (right_ch < n && compare(h, right_ch, highest) > 0) {
-        highest = right_ch;
+    int child;
+    while ((child = DARY_CHILD(index, h->arity_shift)) < n) {
+        int end = child + h->arity < n ? child + h->arity : n;
+        int best = child;
+        for (int c = child + 1; c < end; c++) {
+            if (value_before(h, d[c]->key, d[best]->key)) best = c;
+        }
+        if (!value_before(h, d[best]->key, moving->key)) break;
+        d[index] = d[best];
+        index = best;
     }
-    if (highest != index) {
-        swap(h, highest, index);
-        heapify_down(&h, highest);
+    d[index] = moving;
+}
+
+// Switches the layout to arity children per node and re-heapifies in place.
+bool set_arity(heap *heap_obj , int arity) {
+    if (arity != 2 && arity != 4 && arity != 8 && arity != 16) {
+        printf("Warning: Unsupported heap arity %d, keeping %d.\n", arity, heap_obj->arity);
+        return false;
     }
-} 
+    heap_obj->arity = arity;
+    heap_obj->arity_shift = __builtin_ctz(arity);
+    build_my_heap(&heap_obj);
+    return true;
+}
 
 void build_my_heap(heap **heap_obj) {
     heap *h = *heap_obj;
-    for(int i = h->size/2 - 1 ; i>=0 ; i--) {
-        heapify_down(heap_obj , i );
+    int last_parent = h->size > 1 ? DARY_PARENT(h->size - 1, h->arity_shift) : -1;
+    for(int i = last_parent ; i>=0 ; i--) {
+        if (h->by_value) value_sift_down(h , i , h->size);
+        else heapify_down(heap_obj , i );
     }
 }
 
 void increase_key(heap *heap_obj , int index) {
-    int parent = PARENT(index);
+    int parent = DARY_PARENT(index, heap_obj->arity_shift);
     while (index > 0 && compare(heap_obj, index, parent) > 0) {
         swap(heap_obj, index, parent);
         index = parent;
-        parent = PARENT(index);
+        parent = DARY_PARENT(index, heap_obj->arity_shift);
     }
 }
 
@@ -110,6 +193,13 @@ void heap_insert(heap **heap_obj , void *user_elem , long int key) {
         h->capacity <<= 1;
         resize(heap_obj , h->capacity);
     }
+    if (h->by_value) {
+        h->values[h->size].data = user_elem;
+        h->values[h->size].key = key;
+        h->size++;
+        value_sift_up(h , h->size - 1);
+        return;
+    }
     elem *new_elem = (elem *)malloc(sizeof(elem));
     if (!new_elem) {
         perror("Failed to allocate new element");
@@ -130,6 +220,15 @@ elem *extract_peek(heap **heap_obj) {
         printf("Heap empty\n");
         return NULL;
     }
+    if (h->by_value) { // compatibility path, prefer extract_peek_into
+        elem *copy = (elem *)malloc(sizeof(elem));
+        if (!copy) {
+            perror("Failed to allocate new element");
+            return NULL;
+        }
+        extract_peek_into(heap_obj , copy);
+        return copy;
+    }
     elem *top = h->data[0];
     h->data[0] = h->data[h->size-1];
     h->size--;
@@ -137,6 +236,24 @@ elem *extract_peek(heap **heap_obj) {
     return top;
 }
 
+bool extract_peek_into(heap **heap_obj , elem *out) {
+    heap *h = *heap_obj;
+    if(is_empty(h)) return false;
+    if (!h->by_value) {
+        elem *top = extract_peek(heap_obj);
+        *out = *top;
+        free(top);
+        return true;
+    }
+    *out = h->values[0];
+    h->size--;
+    if (h->size > 0) {
+        h->values[0] = h->values[h->size];
+        value_sift_down(h , 0 , h->size);
+    }
+    return true;
+}
+
 elem **get_heap_sort(heap **heap_obj) {
     heap *h = *heap_obj;
     int original_size = h->size;
@@ -150,6 +267,15 @@ elem **get_heap_sort(heap **heap_obj) {
 void heap_sort(heap **heap_obj) {
     heap *h = *heap_obj;
     int original_size = h->size;
+    if (h->by_value) {
+        for (int i = h->size - 1; i >= 1; i--) {
+            elem top = h->values[0];
+            h->values[0] = h->values[i];
+            h->values[i] = top;
+            value_sift_down(h , 0 , i);
+        }
+        return;
+    }
     for (int i = h->size - 1; i >= 1; i--) {
         swap(h , 0 , i);
         h->size--;
@@ -165,9 +291,10 @@ void print_queue(heap *heap_obj, void (*print_elem)(void *)) {
     }
     printf("Heap (%s-heap, size=%d): \n", heap_obj->is_max ? "max" : "min", heap_obj->size);
     for (int i = 0; i < heap_obj->size; i++) {
-        printf("Index %d: Key=%ld, Data=", i, heap_obj->data[i]->key);
+        elem *e = heap_obj->by_value ? &heap_obj->values[i] : heap_obj->data[i];
+        printf("Index %d: Key=%ld, Data=", i, e->key);
         if (print_elem) {
-            print_elem(heap_obj->data[i]->data);
+            print_elem(e->data);
         } else {
             printf("(no print func)");
         }
@@ -179,12 +306,23 @@ void build_heap_from_array(heap *heap_obj , elem **elements , int num_elements)
     if (num_elements > heap_obj->capacity) {
         resize(&heap_obj, num_elements * 2);
     }
-    memcpy(heap_obj->data, elements, sizeof(elem *) * num_elements);
+    if (heap_obj->by_value) {
+        for (int i = 0; i < num_elements; i++) {
+            heap_obj->values[i] = *elements[i];
+        }
+    } else {
+        memcpy(heap_obj->data, elements, sizeof(elem *) * num_elements);
+    }
     heap_obj->size = num_elements;
     build_my_heap(&heap_obj);
 }
 
 void free_heap(heap *heap_obj) {
+    if (heap_obj->by_value) {
+        free(heap_obj->values);
+        free(heap_obj);
+        return;
+    }
     for (int i = 0; i < heap_obj->size; i++) {
         free(heap_obj->data[i]);
     }
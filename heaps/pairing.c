@@ -0,0 +1,262 @@
+#include "pairing.h"
+
+pairing_heap *pairing_create(const char *type) {
+    pairing_heap *heap_obj = (pairing_heap *)malloc(sizeof(pairing_heap));
+    if (!heap_obj) {
+        perror("Failed to allocate heap structure");
+        return NULL;
+    }
+    heap_obj->size = 0;
+    heap_obj->root = NULL;
+    heap_obj->pool = NULL;
+    if (strcmp(type , "min") == 0) heap_obj->is_max = false;
+    else if (strcmp(type , "max") == 0) heap_obj->is_max = true;
+    else {
+        printf("Warning: Unknown heap type '%s'. Defaulting to Max-Heap.\n", type);
+        heap_obj->is_max = true;
+    }
+    return heap_obj;
+}
+
+// Lazily creates the pool. If an earlier meld emptied this heap's pool into
+// another heap's, follow the chain to the pool that owns the blocks now and
+// hold a reference on that one instead.
+pairing_pool *pairing_pool_of(pairing_heap *heap_obj) {
+    pairing_pool *pool = heap_obj->pool;
+    if (!pool) {
+        pool = (pairing_pool *)calloc(1, sizeof(pairing_pool));
+        if (!pool) {
+            perror("Failed to allocate node pool");
+            return NULL;
+        }
+        pool->refs = 1;
+        heap_obj->pool = pool;
+    } else if (pool->merged_into) {
+        pairing_pool *target = pool->merged_into;
+        while (target->merged_into) target = target->merged_into;
+        target->refs++;
+        pairing_pool_release(pool);
+        heap_obj->pool = target;
+    }
+    return heap_obj->pool;
+}
+
+// Drops one reference; the last one frees the blocks, and a forwarding pool
+// then lets go of the pool it pointed at.
+void pairing_pool_release(pairing_pool *pool) {
+    while (pool && --pool->refs == 0) {
+        pairing_pool *next = pool->merged_into;
+        pairing_block *block = pool->blocks;
+        while (block) {
+            pairing_block *next_block = block->next;
+            free(block);
+            block = next_block;
+        }
+        free(pool);
+        pool = next;
+    }
+}
+
+// Called by meld: from's blocks and free nodes change owner without moving, so
+// every node handle into the melded heap keeps pointing at a live node.
+void pairing_pool_merge(pairing_pool *into, pairing_pool *from) {
+    if (from == into) return;
+    if (from->blocks) {
+        from->blocks_tail->next = into->blocks;
+        if (!into->blocks) into->blocks_tail = from->blocks_tail;
+        into->blocks = from->blocks;
+    }
+    if (from->free_nodes) {
+        from->free_tail->sibling = into->free_nodes;
+        if (!into->free_nodes) into->free_tail = from->free_tail;
+        into->free_nodes = from->free_nodes;
+    }
+    from->blocks = from->blocks_tail = NULL;
+    from->free_nodes = from->free_tail = NULL;
+    from->merged_into = into;
+    into->refs++;
+}
+
+static pairing_node *node_alloc(pairing_heap *heap_obj) {
+    pairing_pool *pool = pairing_pool_of(heap_obj);
+    if (!pool) return NULL;
+    pairing_node *node = pool->free_nodes;
+    if (node) {
+        pool->free_nodes = node->sibling;
+        if (!pool->free_nodes) pool->free_tail = NULL;
+        return node;
+    }
+    pairing_block *block = pool->blocks;
+    if (!block || block->used == PAIRING_BLOCK) {
+        block = (pairing_block *)malloc(sizeof(pairing_block));
+        if (!block) {
+            perror("Failed to allocate node block");
+            return NULL;
+        }
+        block->used = 0;
+        block->next = pool->blocks;
+        if (!pool->blocks) pool->blocks_tail = block;
+        pool->blocks = block;
+    }
+    return &block->nodes[block->used++];
+}
+
+static void node_release(pairing_heap *heap_obj, pairing_node *node) {
+    pairing_pool *pool = pairing_pool_of(heap_obj);
+    node->sibling = pool->free_nodes;
+    if (!pool->free_nodes) pool->free_tail = node;
+    pool->free_nodes = node;
+}
+
+// O(blocks) when this heap is the pool's last user. While a melded-away or
+// melded-into heap still shares the pool, every node is returned to the
+// freelist individually instead, O(n).
+void pairing_free(pairing_heap *heap_obj) {
+    if (!heap_obj) return;
+    if (heap_obj->pool) {
+        pairing_pool *pool = pairing_pool_of(heap_obj);
+        if (pool->refs > 1) { // still shared: hand the nodes back one by one
+            pairing_node *stack = heap_obj->root;
+            while (stack) {
+                pairing_node *node = stack;
+                stack = node->sibling;
+                if (node->child) { // the children's sibling chain joins the stack
+                    pairing_node *last = node->child;
+                    while (last->sibling) last = last->sibling;
+                    last->sibling = stack;
+                    stack = node->child;
+                }
+                node_release(heap_obj, node);
+            }
+        }
+        pairing_pool_release(pool);
+    }
+    free(heap_obj);
+}
+
+int pairing_get_size(pairing_heap *heap_obj) {
+    return heap_obj->size;
+}
+
+bool pairing_is_empty(pairing_heap *heap_obj) {
+    return heap_obj->size == 0;
+}
+
+void *pairing_get_peek(pairing_heap *heap_obj) {
+    if (pairing_is_empty(heap_obj)) {
+        printf("Heap empty\n");
+        return NULL;
+    }
+    return heap_obj->root->data;
+}
+
+// Two roots become one: the one that belongs lower turns into the other's
+// leftmost child.
+pairing_node *pairing_link(pairing_heap *heap_obj, pairing_node *a, pairing_node *b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (heap_obj->is_max ? b->key > a->key : b->key < a->key) {
+        pairing_node *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child) a->child->prev = b;
+    a->child = b;
+    a->sibling = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+// Standard two-pass combine of a sibling list: link neighbours pairwise left
+// to right, then fold the pairs into one tree right to left. Iterative, since
+// a root can have O(n) children.
+pairing_node *pairing_merge_pairs(pairing_heap *heap_obj, pairing_node *first) {
+    pairing_node *pairs = NULL; // linked pairs, last one first, chained through sibling
+    while (first) {
+        pairing_node *a = first;
+        pairing_node *b = a->sibling;
+        first = b ? b->sibling : NULL;
+        a->sibling = NULL;
+        if (b) b->sibling = NULL;
+        pairing_node *pair = pairing_link(heap_obj, a, b);
+        pair->sibling = pairs;
+        pairs = pair;
+    }
+    pairing_node *root = NULL;
+    while (pairs) {
+        pairing_node *next = pairs->sibling;
+        pairs->sibling = NULL;
+        root = pairing_link(heap_obj, root, pairs);
+        pairs = next;
+    }
+    if (root) root->prev = NULL;
+    return root;
+}
+
+// O(1). The returned node is the element's handle for pairing_decrease_key.
+pairing_node *pairing_insert(pairing_heap *heap_obj, void *user_elem, long int key) {
+    pairing_node *node = node_alloc(heap_obj);
+    if (!node) return NULL;
+    node->key = key;
+    node->data = user_elem;
+    node->child = node->sibling = node->prev = NULL;
+    heap_obj->root = pairing_link(heap_obj, heap_obj->root, node);
+    heap_obj->size++;
+    return node;
+}
+
+// Amortized O(log n). The top element's node goes back to the pool.
+bool pairing_extract_peek(pairing_heap *heap_obj, elem *out) {
+    pairing_node *root = heap_obj->root;
+    if (!root) return false;
+    out->key = root->key;
+    out->data = root->data;
+    heap_obj->root = pairing_merge_pairs(heap_obj, root->child);
+    heap_obj->size--;
+    node_release(heap_obj, root);
+    return true;
+}
+
+// Moves node's key toward the top (smaller for a min-heap, larger for a
+// max-heap): its subtree is cut from the parent and linked with the root,
+// amortized O(1). A key moving the other way is refused with a warning.
+bool pairing_decrease_key(pairing_heap *heap_obj, pairing_node *node, long int key) {
+    if (heap_obj->is_max ? key < node->key : key > node->key) {
+        printf("Warning: pairing_decrease_key can only move a key toward the top.\n");
+        return false;
+    }
+    node->key = key;
+    if (node == heap_obj->root) return true;
+    if (node->prev->child == node) { // leftmost child: prev is the parent
+        node->prev->child = node->sibling;
+    } else {
+        node->prev->sibling = node->sibling;
+    }
+    if (node->sibling) node->sibling->prev = node->prev;
+    node->sibling = NULL;
+    heap_obj->root = pairing_link(heap_obj, heap_obj->root, node);
+    return true;
+}
+
+// O(1): the two roots are linked and b's pool joins a's. Both heaps must have
+// the same type. Consumes b and returns a; handles into b stay valid.
+pairing_heap *pairing_meld(pairing_heap *a, pairing_heap *b) {
+    if (a->is_max != b->is_max) {
+        printf("Warning: cannot meld a min-heap with a max-heap.\n");
+        return NULL;
+    }
+    if (b->pool) {
+        pairing_pool *pool = pairing_pool_of(a);
+        pairing_pool *other = pairing_pool_of(b);
+        if (!pool || !other) return NULL;
+        pairing_pool_merge(pool, other);
+    }
+    a->root = pairing_link(a, a->root, b->root);
+    a->size += b->size;
+    b->root = NULL;
+    b->size = 0;
+    pairing_free(b);
+    return a;
+}
@@ -0,0 +1,64 @@
+#ifndef PAIRING_H
+#define PAIRING_H
+
+#include "header.h"
+
+// Pairing heap over the same (key, data) elements as heap.c. Every subtree
+// is a heap-ordered multiway tree stored as leftmost child + next sibling;
+// insert and meld are a single link of two roots, extract re-links the old
+// root's children in two passes. pairing_insert hands back the node as a
+// handle for pairing_decrease_key, valid until that element is extracted.
+
+#define PAIRING_BLOCK 256 // nodes per pool block
+
+typedef struct pairing_node_struct {
+    long int key;
+    void *data;
+    struct pairing_node_struct *child;   // leftmost child
+    struct pairing_node_struct *sibling; // next sibling, or next free node in the pool
+    struct pairing_node_struct *prev;    // previous sibling, or parent for a leftmost child
+} pairing_node;
+
+typedef struct pairing_block_struct {
+    struct pairing_block_struct *next;
+    int used;
+    pairing_node nodes[PAIRING_BLOCK];
+} pairing_block;
+
+// Melding heaps with different pools moves the blocks of one into the other
+// and leaves a forwarding pointer for the heaps still holding the old pool.
+// meld itself is O(1), but a pool outlives the heaps that shared it: freeing
+// a heap whose pool another heap still uses walks its nodes back onto the
+// freelist one by one, O(n); only the last heap frees the blocks in O(blocks).
+typedef struct pairing_pool_struct {
+    pairing_block *blocks;
+    pairing_block *blocks_tail;
+    pairing_node *free_nodes;
+    pairing_node *free_tail;
+    int refs; // heaps holding this pool, plus emptied pools that forward here
+    struct pairing_pool_struct *merged_into;
+} pairing_pool;
+
+typedef struct pairing_heap_struct {
+    int size;
+    bool is_max;
+    pairing_node *root;
+    pairing_pool *pool; // created with the first node
+} pairing_heap;
+
+pairing_heap *pairing_create(const char *type);
+void pairing_free(pairing_heap *heap_obj);
+int pairing_get_size(pairing_heap *heap_obj);
+bool pairing_is_empty(pairing_heap *heap_obj);
+void *pairing_get_peek(pairing_heap *heap_obj);
+pairing_node *pairing_insert(pairing_heap *heap_obj, void *user_elem, long int key);
+bool pairing_extract_peek(pairing_heap *heap_obj, elem *out);
+bool pairing_decrease_key(pairing_heap *heap_obj, pairing_node *node, long int key);
+pairing_heap *pairing_meld(pairing_heap *a, pairing_heap *b);
+pairing_pool *pairing_pool_of(pairing_heap *heap_obj);
+void pairing_pool_release(pairing_pool *pool);
+void pairing_pool_merge(pairing_pool *into, pairing_pool *from);
+pairing_node *pairing_link(pairing_heap *heap_obj, pairing_node *a, pairing_node *b);
+pairing_node *pairing_merge_pairs(pairing_heap *heap_obj, pairing_node *first);
+
+#endif
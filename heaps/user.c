@@ -1,4 +1,5 @@
 #include "header.h"
+#include "pairing.h"
 #include <time.h>
 
 #define MAX 100
@@ -11,7 +12,115 @@ void print_double(void *data) {
         printf("%0.2lf", *(double *)data);
 }
 
-int main() {
+void test_pairing_heap() {
+    printf("Testing pairing Min-Heap with meld and decrease_key:\n");
+    pairing_heap *a = pairing_create("min");
+    pairing_heap *b = pairing_create("min");
+    int values[10];
+    pairing_node *handles[10];
+    for (int i = 0; i < 10; i++) {
+        values[i] = rand() % 100;
+        handles[i] = pairing_insert(i % 2 ? a : b, &values[i], values[i]);
+    }
+    printf("Sizes before meld: %d + %d\n", pairing_get_size(a), pairing_get_size(b));
+    a = pairing_meld(a, b);
+    printf("Size after meld: %d, peek: %d\n", pairing_get_size(a), *(int *)pairing_get_peek(a));
+    pairing_decrease_key(a, handles[7], -1);
+    printf("After decrease_key of %d's key to -1, peek data: %d\n", values[7], *(int *)pairing_get_peek(a));
+
+    elem top;
+    printf("Drained (min, ascending): ");
+    while (pairing_extract_peek(a, &top)) {
+        printf("%ld ", top.key);
+    }
+    printf("\n");
+    pairing_free(a);
+}
+
+// Per-worker frontier queues merged into one: a pairing meld links two roots,
+// the binary heap has to re-insert every element of the other queue.
+void bench_meld(int num_elements) {
+    const int workers = 8;
+    int per_worker = num_elements / workers;
+    pairing_heap *queues[8];
+    heap *binary[8];
+    for (int w = 0; w < workers; w++) {
+        queues[w] = pairing_create("min");
+        binary[w] = build_value_heap(per_worker, "min");
+        for (int i = 0; i < per_worker; i++) {
+            long int key = rand();
+            pairing_insert(queues[w], NULL, key);
+            heap_insert(&binary[w], NULL, key);
+        }
+    }
+    clock_t start = clock();
+    for (int w = 1; w < workers; w++) {
+        queues[0] = pairing_meld(queues[0], queues[w]);
+    }
+    double pairing_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int w = 1; w < workers; w++) {
+        elem e;
+        while (extract_peek_into(&binary[w], &e)) {
+            heap_insert(&binary[0], e.data, e.key);
+        }
+        free_heap(binary[w]);
+    }
+    double binary_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    printf("Meld %d queues of %d: pairing %.3f ms, binary re-insert %.2f ms\n",
+           workers, per_worker, pairing_ms, binary_ms);
+
+    start = clock();
+    elem e;
+    while (pairing_extract_peek(queues[0], &e));
+    double drain_pairing_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    while (extract_peek_into(&binary[0], &e));
+    double drain_binary_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    printf("Drain %d: pairing %.2f ms, binary %.2f ms\n", workers * per_worker, drain_pairing_ms, drain_binary_ms);
+    pairing_free(queues[0]);
+    free_heap(binary[0]);
+}
+
+// One mixed run on a by-value min-heap prefilled with num_elements random keys:
+// num_elements operations, insert_pct percent of them inserts, the rest extracts.
+double run_arity_mix(int arity, int num_elements, int insert_pct) {
+    heap *h = build_value_heap(num_elements * 2, "min");
+    set_arity(h, arity);
+    srand(7); // same keys and op sequence for every arity
+    for (int i = 0; i < num_elements; i++) {
+        heap_insert(&h, NULL, rand());
+    }
+    elem top;
+    clock_t start = clock();
+    for (int i = 0; i < num_elements; i++) {
+        if (rand() % 100 < insert_pct) heap_insert(&h, NULL, rand());
+        else extract_peek_into(&h, &top);
+    }
+    double ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    free_heap(h);
+    return ms;
+}
+
+void bench_arity(int num_elements) {
+    printf("d-ary heap, %d prefilled + %d ops (ms):\n", num_elements, num_elements);
+    printf("arity  insert-heavy(75%%)  extract-heavy(25%%)\n");
+    int arities[] = {2, 4, 8, 16};
+    for (int i = 0; i < 4; i++) {
+        double insert_ms = run_arity_mix(arities[i], num_elements, 75);
+        double extract_ms = run_arity_mix(arities[i], num_elements, 25);
+        printf("%5d  %17.2f  %18.2f\n", arities[i], insert_ms, extract_ms);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) { // ./gen_heap bench [elements]
+        int num_elements = argc > 2 ? atoi(argv[2]) : 1000000;
+        srand(42);
+        bench_meld(num_elements);
+        bench_arity(num_elements);
+        return 0;
+    }
     heap *max_int_h = build_heap(20, "max");
     
     printf("Testing Max-Heap with random ints:\n");
@@ -66,7 +175,7 @@ int main() {
     printf("Peek: %0.2lf\n", *(double *)get_peek(max_double_h));
     
     elem *ext2 = extract_peek(&max_double_h);
-    printf("Extracted: key=%ld", ext1->key);
+    printf("Extracted: key=%ld, value=", ext2->key);
     print_double(ext2->data);
     printf("\n");
     free(ext2->data);
@@ -88,4 +197,27 @@ int main() {
     free(sorted_double);
     
     free_heap(max_double_h);
+
+    heap *value_h = build_value_heap(16, "min");
+    set_arity(value_h, 4);
+
+    printf("Testing by-value 4-ary Min-Heap with random ints:\n");
+    int values[MAX];
+    for (int i = 0; i < MAX; i++) {
+        values[i] = rand() % 100;
+        heap_insert(&value_h, &values[i], values[i]);
+    }
+    printf("Size: %d\n", get_size(value_h));
+    printf("Peek: %d\n", *(int *)get_peek(value_h));
+
+    elem top;
+    printf("Drained (min, ascending): ");
+    while (extract_peek_into(&value_h, &top)) {
+        printf("%ld ", top.key);
+    }
+    printf("\n");
+
+    free_heap(value_h);
+
+    test_pairing_heap();
 }
\ No newline at end of file